@@ -0,0 +1,96 @@
+/* Appending of formatted records by several threads to one buffer.
+ * Concurrent append mode is compared with a plain buffer under a mutex
+ * and with a buffer locked by itself (flag 'l'),
+ * count of complete records is checked, time is printed for each count of threads.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+#include <iobuffer/iobuffer.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_THREADS 64
+#define ITERATIONS  100000
+
+typedef struct {
+    BUFFER* buf;
+    pthread_mutex_t lock;
+    int locked;
+} shared_t;
+
+static void* worker(void* arg) {
+    shared_t* shared = arg;
+    int i;
+
+    for (i = 0; i < ITERATIONS; i++) {
+        if (shared->locked) pthread_mutex_lock(&shared->lock);
+        bprintf(shared->buf, "%d %5.2f %-6s %x\n", i, i * 0.25, "record", i);
+        if (shared->locked) pthread_mutex_unlock(&shared->lock);
+    }
+    return NULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* every record ends with newline, torn record would change their count */
+static long records(BUFFER* buf) {
+    char line[64]; long count = 0;
+    while (bgets(line, sizeof line, buf))
+        if (line[strlen(line) - 1] == '\n') count++;
+    return count;
+}
+
+/* mode of shared buffer, mutex is taken by workers for plain buffer */
+static double run(int count, const char* mode, int* failed) {
+    pthread_t threads[MAX_THREADS]; shared_t shared;
+    double start, elapsed;
+    int i;
+
+    shared.buf = bopen(NULL, 0, mode);
+    shared.locked = strcmp(mode, "w+") == 0;
+    pthread_mutex_init(&shared.lock, NULL);
+
+    start = now();
+    for (i = 0; i < count; i++)
+        pthread_create(&threads[i], NULL, worker, &shared);
+    for (i = 0; i < count; i++)
+        pthread_join(threads[i], NULL);
+    elapsed = now() - start;
+
+    brewind(shared.buf);
+    if (records(shared.buf) != (long)count * ITERATIONS) (*failed)++;
+
+    pthread_mutex_destroy(&shared.lock);
+    bclose(shared.buf);
+    return elapsed;
+}
+
+int main(int argc, char** argv) {
+    int maxthreads = argc > 1 ? atoi(argv[1]) : 8;
+    int count, failed = 0;
+    double concurrent, mutex, locked;
+
+    if (maxthreads < 1 || maxthreads > MAX_THREADS) {
+        fprintf(stderr, "usage: %s [threads 1..%d]\n", argv[0], MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    printf("threads  concurrent    mutex   locked  (seconds)\n");
+    for (count = 1; count <= maxthreads; count *= 2) {
+        concurrent = run(count, "w+m", &failed);
+        mutex = run(count, "w+", &failed);
+        locked = run(count, "w+l", &failed);
+        printf("%7d  %10.3f  %7.3f  %7.3f\n", count, concurrent, mutex, locked);
+    }
+
+    if (failed) fprintf(stderr, "%d runs lost records\n", failed);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
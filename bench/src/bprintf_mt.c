@@ -0,0 +1,87 @@
+/* Formatting by several threads, each to its own buffer.
+ * Output of every thread is compared with output of one thread,
+ * time is printed for each count of threads.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+#include <iobuffer/iobuffer.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_THREADS 64
+#define ITERATIONS  200000
+
+typedef struct {
+    BUFFER* buf;
+} job_t;
+
+static void format(BUFFER* buf) {
+    int i;
+    brewind(buf);
+    for (i = 0; i < ITERATIONS; i++)
+        bprintf(buf, "%d %5.2f %e %a %-6s %x|", i, i * 0.25, i * 1e-3, i * 0.5, "text", i);
+}
+
+static void* worker(void* arg) {
+    format(((job_t*)arg)->buf);
+    return NULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    pthread_t threads[MAX_THREADS]; job_t jobs[MAX_THREADS];
+    BUFFER* reference; BUFVIEW expect, got;
+    int maxthreads = argc > 1 ? atoi(argv[1]) : 8;
+    int count, i, failed = 0;
+    double start, elapsed, single = 0;
+
+    if (maxthreads < 1 || maxthreads > MAX_THREADS) {
+        fprintf(stderr, "usage: %s [threads 1..%d]\n", argv[0], MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    reference = bopen(NULL, 0, "w");
+    format(reference);
+    expect = bview(reference);
+
+    for (i = 0; i < maxthreads; i++)
+        jobs[i].buf = bopen(NULL, 0, "w");
+
+    printf("threads  seconds  Mcalls/s  speedup\n");
+    for (count = 1; count <= maxthreads; count *= 2) {
+        start = now();
+        for (i = 0; i < count; i++)
+            pthread_create(&threads[i], NULL, worker, &jobs[i]);
+        for (i = 0; i < count; i++)
+            pthread_join(threads[i], NULL);
+        elapsed = now() - start;
+        if (count == 1) single = elapsed;
+
+        /* corrupted scratch space would change output of some thread */
+        for (i = 0; i < count; i++) {
+            got = bview(jobs[i].buf);
+            if (BV_LEN(got, base, stop) != BV_LEN(expect, base, stop)
+            || memcmp(got.base, expect.base, BV_LEN(expect, base, stop)))
+                failed++;
+        }
+
+        printf("%7d  %7.3f  %8.2f  %7.2f\n", count, elapsed,
+            count * (double)ITERATIONS / elapsed * 1e-6, single * count / elapsed);
+    }
+
+    for (i = 0; i < maxthreads; i++)
+        bclose(jobs[i].buf);
+    bclose(reference);
+
+    if (failed) fprintf(stderr, "%d outputs differ from reference\n", failed);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/* Transfer of records from one producer thread to one consumer thread.
+ * Ring mode buffer is compared with queue mode buffer under a mutex,
+ * both hold at most CAPACITY bytes, a thread without progress yields.
+ * Consumer checks order of records, time is printed for each variant.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+#include <iobuffer/iobuffer.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RECORDS  20000000
+#define BATCH    16
+#define CAPACITY 65536
+
+typedef struct {
+    BUFFER* buf;
+    pthread_mutex_t lock;
+    int locked;
+} channel_t;
+
+static size_t put(channel_t* ch, const long* recs, size_t count) {
+    size_t done;
+    if (!ch->locked) return bwrite(recs, sizeof *recs, count, ch->buf);
+
+    pthread_mutex_lock(&ch->lock);
+    bseek(ch->buf, 0, BSEEK_END);
+    done = (CAPACITY - btell(ch->buf)) / sizeof *recs;
+    done = bwrite(recs, sizeof *recs, done < count ? done : count, ch->buf);
+    pthread_mutex_unlock(&ch->lock);
+    return done;
+}
+
+static size_t get(channel_t* ch, long* recs, size_t count) {
+    size_t done;
+    if (!ch->locked) return bread(recs, sizeof *recs, count, ch->buf);
+
+    pthread_mutex_lock(&ch->lock);
+    brewind(ch->buf);
+    done = bread(recs, sizeof *recs, count, ch->buf);
+    brewind(ch->buf);
+    berase(ch->buf, done * sizeof *recs);
+    pthread_mutex_unlock(&ch->lock);
+    return done;
+}
+
+static void* producer(void* arg) {
+    channel_t* ch = arg;
+    long recs[BATCH], next = 0;
+    size_t i, part, done = 0;
+
+    while (next < RECORDS) {
+        if (done == 0)
+            for (i = 0; i < BATCH; i++) recs[i] = next + i;
+        part = put(ch, recs + done, BATCH - done);
+        if (!part) sched_yield();
+        done += part;
+        if (done == BATCH) {
+            next += BATCH;
+            done = 0;
+        }
+    }
+    return NULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int run(const char* name, channel_t* ch) {
+    pthread_t thread; long recs[BATCH], expect = 0;
+    size_t i, got; int failed = 0;
+    double start, elapsed;
+
+    start = now();
+    pthread_create(&thread, NULL, producer, ch);
+    while (expect < RECORDS) {
+        got = get(ch, recs, BATCH);
+        if (!got) sched_yield();
+        for (i = 0; i < got; i++)
+            if (recs[i] != expect++) failed = 1;
+    }
+    pthread_join(thread, NULL);
+    elapsed = now() - start;
+
+    printf("%-8s  %7.3f  %9.2f\n", name, elapsed, RECORDS / elapsed * 1e-6);
+    return failed;
+}
+
+int main(void) {
+    BOPTIONS opts; channel_t ring, queue;
+    int failed = 0;
+
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w+c";
+    opts.capacity = CAPACITY;
+    ring.buf = bopenex(&opts);
+    ring.locked = 0;
+
+    opts.mode = "w+q";
+    queue.buf = bopenex(&opts);
+    queue.locked = 1;
+    pthread_mutex_init(&queue.lock, NULL);
+
+    if (!ring.buf || !queue.buf) {
+        fprintf(stderr, "buffers are not opened\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("variant   seconds  Mrecords/s\n");
+    failed += run("ring", &ring);
+    failed += run("mutex", &queue);
+
+    pthread_mutex_destroy(&queue.lock);
+    bclose(ring.buf);
+    bclose(queue.buf);
+
+    if (failed) fprintf(stderr, "%d variants broke order of records\n", failed);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -58,12 +58,31 @@ extern "C" {
 #define BSEEK_SET 0
 #define BSEEK_CUR 1
 #define BSEEK_END 2
+#define BRESET_WIPE    1
+#define BRESET_RELEASE 2
 
 /* Types */
 
 typedef struct BUFFER BUFFER;
 typedef size_t bpos_t;
-typedef void* (*balloc_t)(void* ptr, size_t size, void* userdata);
+typedef void*  (*balloc_t )(void* ptr, size_t size, void* userdata);
+typedef int    (*bsink_t  )(const void* data, size_t size, void* userdata);
+typedef size_t (*bsource_t)(void* data, size_t size, void* userdata);
+
+typedef struct BOPTIONS {
+    const void* data;      /* content and mode as in bopen */
+    size_t      size;
+    const char* mode;
+    balloc_t    allocator; /* null for default, global allocator is not used */
+    void*       userdata;
+    size_t      capacity;  /* allocated at open, zero for first write */
+    unsigned    growth;    /* new capacity in percents of old, zero for default */
+    size_t      threshold; /* capacity from which growth is linear by step */
+    size_t      step;      /* zero for geometric growth only */
+    int         exact;     /* nonzero for capacity equal to required */
+    size_t      reserve;   /* address range reserved at open, storage never moves */
+    int         hugepages; /* nonzero for transparent huge pages in reserved range */
+} BOPTIONS;
 
 /* Allocation */
 
@@ -72,14 +91,62 @@ B_API int bsetalloc(balloc_t allocator, void* userdata);
 /* Buffer access */
 
 B_API int bclose(BUFFER* buffer);
+B_API int bsync (BUFFER* buffer);
 
 B_API BUFFER* bopen   (const void* restrict data, size_t size, const char* restrict mode) B_ATTR_MALLOC;
 B_API BUFFER* bmemopen(      void* restrict data, size_t size, const char* restrict mode) B_ATTR_MALLOC;
+B_API BUFFER* bborrow (const void*          data, size_t size) B_ATTR_MALLOC;
+B_API BUFFER* bopenex (const BOPTIONS* options) B_ATTR_MALLOC;
+
+B_API BUFFER* bmmapopen(const char* restrict path, const char* restrict mode) B_ATTR_MALLOC;
+
+B_API BUFFER* battach(void* restrict data, size_t size, size_t capacity, const char* restrict mode) B_ATTR_MALLOC;
+B_API void*   bdetach(BUFFER* restrict buffer, size_t* restrict size);
+
+/* Arena extension */
+
+typedef struct BARENA BARENA;
+
+B_API BARENA* barenaopen (size_t blocksize);
+B_API void    barenaclose(BARENA* arena);
+B_API void    barenareset(BARENA* arena);
+
+B_API void* barenaalloc(void* ptr, size_t size, void* arena);
+
+/* Pool extension */
+
+typedef struct BPOOL  BPOOL;
+typedef struct BCACHE BCACHE;
+
+B_API BPOOL* bpoolopen (size_t retain);
+B_API void   bpoolclose(BPOOL* pool);
+
+B_API BUFFER* bpoolget(BPOOL* restrict pool, size_t capacity, const char* restrict mode);
+B_API int     bpoolput(BPOOL* restrict pool, BUFFER* restrict buffer);
+
+B_API BCACHE* bcacheopen (BPOOL* pool);
+B_API void    bcacheclose(BCACHE* cache);
+
+B_API BUFFER* bcacheget(BCACHE* restrict cache, size_t capacity, const char* restrict mode);
+B_API int     bcacheput(BCACHE* restrict cache, BUFFER* restrict buffer);
+
+/* Sharing extension */
+
+B_API int     bfreeze(BUFFER* buffer);
+B_API BUFFER* bclone (BUFFER* buffer) B_ATTR_MALLOC;
+
+/* Streaming */
+
+B_API int bsetsink(BUFFER* buffer, bsink_t sink, void* userdata, size_t limit);
+B_API int bsetsource(BUFFER* buffer, bsource_t source, void* userdata);
 
 /* Operations on buffer */
 
-B_API int berase(BUFFER* buffer, size_t count);
+B_API int binsert(const void* restrict data, size_t size, BUFFER* restrict buffer);
+B_API int berase (BUFFER* buffer, size_t count);
 B_API int breset(BUFFER* buffer);
+B_API int bresetex(BUFFER* buffer, int flags);
+B_API int bshrink(BUFFER* buffer);
 
 /* Buffer positioning */
 
@@ -96,6 +163,27 @@ B_API void brewind(BUFFER* buffer);
 B_API size_t bread (      void* restrict data, size_t size, size_t count, BUFFER* restrict buffer);
 B_API size_t bwrite(const void* restrict data, size_t size, size_t count, BUFFER* restrict buffer);
 
+/* Direct access extension */
+
+B_API void* bwritebegin (BUFFER* restrict buffer, size_t minsize, size_t* restrict avail);
+B_API int   bwritecommit(BUFFER*          buffer, size_t count);
+
+B_API const void* bpeekspan(BUFFER* restrict buffer, size_t* restrict length);
+B_API int         bconsume (BUFFER*          buffer, size_t count);
+
+/* Vectored input/output extension */
+
+typedef struct BUFVEC {
+    void*  base;
+    size_t size;
+} BUFVEC;
+
+B_API size_t breadv (BUFFER* restrict buffer, const BUFVEC* restrict vector, size_t count);
+B_API size_t bwritev(BUFFER* restrict buffer, const BUFVEC* restrict vector, size_t count);
+
+B_API long bfillfd (BUFFER* buffer, int fd, size_t max);
+B_API long bdrainfd(BUFFER* buffer, int fd);
+
 /* Unformatted input/output */
 
 B_API int bgetc(BUFFER* buffer);
@@ -130,10 +218,53 @@ typedef struct BUFVIEW {
 
 B_API BUFVIEW bview(BUFFER* buffer);
 
+typedef struct BUFSPAN {
+    const void* base;
+    size_t      size;
+} BUFSPAN;
+
+B_API size_t bviewv(BUFFER* restrict buffer, BUFSPAN* restrict spans, size_t count);
+
 #define BV_FMT "%.*s"
 #define BV_ARG(view, begin, end) (int)BV_LEN(view, begin, end), (const char*)(view).begin
 #define BV_LEN(view, begin, end) ((char*)(view).end - (char*)(view).begin)
 
+/* Reader extension */
+
+typedef struct BREADER {
+    BUFFER* buffer;
+    bpos_t  pos;
+} BREADER;
+
+B_API BREADER breader(BUFFER* buffer);
+
+B_API int    brgetc(BREADER* reader);
+B_API char*  brgets(char* restrict str, int count, BREADER* restrict reader);
+B_API size_t brread(void* restrict data, size_t size, size_t count, BREADER* restrict reader);
+
+B_API int  brscanf(BREADER* restrict reader, const char* restrict format, ...         ) B_ATTR_SCAN__FMT(3);
+B_API int vbrscanf(BREADER* restrict reader, const char* restrict format, va_list list) B_ATTR_SCAN__FMT(0);
+
+/* Locking extension */
+
+B_API void block  (BUFFER* buffer);
+B_API void bunlock(BUFFER* buffer);
+
+B_API int   bgetc_unlocked(BUFFER* buffer);
+B_API char* bgets_unlocked(char* restrict str, int count, BUFFER* restrict buffer);
+
+B_API int bputc_unlocked(int byte, BUFFER* buffer);
+B_API int bputs_unlocked(const char* restrict string, BUFFER* restrict buffer);
+
+B_API size_t bread_unlocked (      void* restrict data, size_t size, size_t count, BUFFER* restrict buffer);
+B_API size_t bwrite_unlocked(const void* restrict data, size_t size, size_t count, BUFFER* restrict buffer);
+
+B_API int   bscanf_unlocked(BUFFER* restrict buffer, const char* restrict format, ...         ) B_ATTR_SCAN__FMT(3);
+B_API int  vbscanf_unlocked(BUFFER* restrict buffer, const char* restrict format, va_list list) B_ATTR_SCAN__FMT(0);
+
+B_API int  bprintf_unlocked(BUFFER* restrict buffer, const char* restrict format, ...         ) B_ATTR_PRINT_FMT(3);
+B_API int vbprintf_unlocked(BUFFER* restrict buffer, const char* restrict format, va_list list) B_ATTR_PRINT_FMT(0);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,47 @@
+/* * * * * * * * * * * * * * * * * * * * * *
+ * Asynchronous fill and drain of buffers  *
+ * with one io_uring instance. Linux only, *
+ * built with option IOBUFFER_URING.       *
+ * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef IOBUFFER_URING_H
+#define IOBUFFER_URING_H
+
+#include <iobuffer/iobuffer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Types */
+
+typedef struct BURING BURING;
+
+typedef struct BUREVENT {
+    BUFFER* buffer;
+    void*   userdata;
+    long    result; /* bytes, 0 at end of file or negative errno */
+    int     drain;  /* nonzero for completion of burdrain */
+} BUREVENT;
+
+/* Ring access */
+
+B_API BURING* buropen (unsigned entries);
+/* cancels operations in flight and waits for their completions,
+ * ring is not closed and EOB is returned if waiting fails */
+B_API int     burclose(BURING* ring);
+
+B_API int burregister(BURING* restrict ring, BUFFER* const* restrict buffers, unsigned count);
+
+/* Operations */
+
+B_API int burfill (BURING* ring, BUFFER* buffer, int fd, size_t max, void* userdata);
+B_API int burdrain(BURING* ring, BUFFER* buffer, int fd,             void* userdata);
+
+B_API int burwait(BURING* restrict ring, BUREVENT* restrict events, int count, int minimum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IOBUFFER_URING_H */
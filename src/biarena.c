@@ -0,0 +1,131 @@
+#include <iobuffer/iobuffer.h>
+#include "bidefine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define B_ARENA_BLOCK 65536
+
+/* alignment of allocations is the strictest of basic types */
+typedef union bialign_t {
+    long        l;
+    double      d;
+    long double ld;
+    void*       p;
+} bialign_t;
+
+#define biround(size) (((size) + sizeof(bialign_t) - 1) / sizeof(bialign_t) * sizeof(bialign_t))
+
+typedef struct biblock_t {
+    struct biblock_t* next;
+    size_t size; /* bytes of data after header */
+} biblock_t;
+
+/* allocation is preceded by its requested size for moving */
+#define B_BLOCK_HEADER biround(sizeof(biblock_t))
+#define B_ITEM_HEADER  biround(sizeof(size_t))
+
+#define bidata(block) ((uchar*)(block) + B_BLOCK_HEADER)
+#define bisize(ptr)   (*(size_t*)((uchar*)(ptr) - B_ITEM_HEADER))
+
+/* blocks are kept after reset, so they are reused by next allocations */
+struct BARENA {
+    biblock_t* first;
+    biblock_t* current;
+    size_t     used; /* bytes of current block */
+    uchar*     last; /* allocation at the end of used bytes */
+    size_t     blocksize;
+};
+
+static void* biplace(BARENA* arena, size_t size, size_t need) {
+    uchar* ptr = bidata(arena->current) + arena->used + B_ITEM_HEADER;
+    arena->used += B_ITEM_HEADER + need;
+    arena->last = ptr;
+    bisize(ptr) = size;
+    return ptr;
+}
+
+static void* bipush(BARENA* arena, size_t size) {
+    size_t need = biround(size), total = B_ITEM_HEADER + need;
+    size_t blocksize = total > arena->blocksize ? total : arena->blocksize;
+    biblock_t* block;
+
+    if (arena->current && arena->used + total <= arena->current->size)
+        return biplace(arena, size, need);
+
+    /* next blocks are free since reset */
+    while (arena->current && arena->current->next) {
+        arena->current = arena->current->next;
+        arena->used = 0;
+        if (total <= arena->current->size) return biplace(arena, size, need);
+    }
+
+    block = malloc(B_BLOCK_HEADER + blocksize);
+    if (!block) return NULL;
+    block->next = NULL;
+    block->size = blocksize;
+
+    if (arena->current) arena->current->next = block;
+    else arena->first = block;
+    arena->current = block;
+    arena->used = 0;
+    return biplace(arena, size, need);
+}
+
+BARENA* barenaopen(size_t blocksize) {
+    BARENA* arena = calloc(1, sizeof *arena);
+    if (!arena) return NULL;
+
+    arena->blocksize = blocksize ? biround(blocksize) : B_ARENA_BLOCK;
+    return arena;
+}
+
+void barenaclose(BARENA* arena) {
+    biblock_t* block;
+    if (!arena) return;
+
+    while ((block = arena->first)) {
+        arena->first = block->next;
+        free(block);
+    }
+    free(arena);
+}
+
+/* buffers still open keep pointers into blocks, so they are closed
+ * before reset, arena does not know them */
+void barenareset(BARENA* arena) {
+    if (!arena) return;
+
+    arena->current = arena->first;
+    arena->used = 0;
+    arena->last = NULL;
+}
+
+void* barenaalloc(void* ptr, size_t size, void* userdata) {
+    BARENA* arena = userdata; void* mem;
+    if (!arena) return NULL;
+
+    if (size == 0) {
+        /* only the last allocation returns its bytes */
+        if (ptr && ptr == arena->last) {
+            arena->used = arena->last - B_ITEM_HEADER - bidata(arena->current);
+            arena->last = NULL;
+        }
+        return NULL;
+    }
+    if (size > SIZE_MAX - B_BLOCK_HEADER - B_ITEM_HEADER - sizeof(bialign_t)) return NULL;
+
+    /* the last allocation grows or shrinks in place */
+    if (ptr && ptr == arena->last) {
+        size_t offset = arena->last - bidata(arena->current);
+        if (offset + biround(size) <= arena->current->size) {
+            arena->used = offset + biround(size);
+            bisize(ptr) = size;
+            return ptr;
+        }
+    }
+
+    mem = bipush(arena, size);
+    if (mem && ptr) memcpy(mem, ptr, bisize(ptr) < size ? bisize(ptr) : size);
+    return mem;
+}
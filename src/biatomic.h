@@ -0,0 +1,68 @@
+#ifndef IOBUFFER_ATOMIC_H
+#define IOBUFFER_ATOMIC_H
+
+/* Atomic operations on 'long' for library compiled as C89,
+ * so compiler builtins are used instead of <stdatomic.h>
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#  define B_ATOMIC 1
+
+#  define biatomicload(ptr)        __atomic_load_n    ((ptr),        __ATOMIC_ACQUIRE)
+#  define biatomicstore(ptr, val)  __atomic_store_n   ((ptr), (val), __ATOMIC_RELEASE)
+#  define biatomicadd(ptr, val)    __atomic_fetch_add ((ptr), (val), __ATOMIC_ACQ_REL)
+#  define biatomicswap(ptr, val)   __atomic_exchange_n((ptr), (val), __ATOMIC_ACQUIRE)
+#  define biatomicpause()          ((void)0)
+
+#elif defined(_MSC_VER)
+
+#  include <intrin.h>
+
+#  define B_ATOMIC 1
+
+/* volatile access on x86 and x64 has acquire and release semantics */
+#  define biatomicload(ptr)        (*(volatile long*)(ptr))
+#  define biatomicstore(ptr, val)  ((void)_InterlockedExchange    ((volatile long*)(ptr), (val)))
+#  define biatomicadd(ptr, val)    (         _InterlockedExchangeAdd((volatile long*)(ptr), (val)))
+#  define biatomicswap(ptr, val)   (         _InterlockedExchange   ((volatile long*)(ptr), (val)))
+#  define biatomicpause()          _mm_pause()
+
+#else
+
+/* without atomics objects are not shared between threads */
+#  define biatomicload(ptr)        (*(ptr))
+#  define biatomicstore(ptr, val)  ((void)(*(ptr) = (val)))
+#  define biatomicadd(ptr, val)    ((*(ptr) += (val)) - (val))
+#  define biatomicswap(ptr, val)   bifallbackswap((ptr), (val))
+#  define biatomicpause()          ((void)0)
+
+static long bifallbackswap(long* ptr, long val) {
+    long old = *ptr; *ptr = val;
+    return old;
+}
+
+#endif
+
+/* Waiting thread spins shortly, then gives processor to others,
+ * so preempted owner of awaited state can finish (needs bidefine.h) */
+
+#define B_SPIN_LIMIT 64
+
+#define biatomicwait(spins) ((spins)++ < B_SPIN_LIMIT ? biatomicpause() : bisysyield())
+
+/* Spin lock for short critical sections */
+
+typedef long bilock_t;
+
+#define B_LOCK_INIT 0
+
+#define bilock(lock) do {                                   \
+    int bispins = 0;                                        \
+    while (biatomicswap((lock), 1))                         \
+        while (biatomicload(lock)) biatomicwait(bispins);   \
+} while (0)
+
+#define biunlock(lock) biatomicstore((lock), 0)
+
+#endif /* IOBUFFER_ATOMIC_H */
@@ -59,6 +59,52 @@ int biimmcmp (const char* str, size_t len, BUFFER* buf, int* accumulator);
 int biimmpeek(BUFFER* buf);
 int biimmskip(BUFFER* buf);
 
+/* Declarations of storage functions for asynchronous io, storage is
+ * used by kernel until completion, so position is moved after it */
+
+void* bispare       (BUFFER* buf, size_t max, size_t* len);
+void  biappend      (BUFFER* buf, size_t len);
+void  biconsume     (BUFFER* buf, size_t len);
+void* bifixedstorage(BUFFER* buf, size_t* size);
+
+/* buffer has at most one operation in flight,
+ * its storage is neither moved nor flushed until completion */
+bool  biinflight    (const BUFFER* buf);
+void  bimarkio      (BUFFER* buf, bool inflight);
+
+/* allocator set by bsetalloc for objects of extensions */
+void  bicurrentalloc(balloc_t* alloc, void** udata);
+
+/* Declarations of storage functions for pool, buffer is reopened
+ * with the same storage and empty content */
+
+size_t bicapacity (BUFFER* buf);
+int    bireuse    (BUFFER* buf, const char* mode);
+int    bireusemode(const char* mode); /* fails if buffer can not be reused in 'mode' */
+
+/* Declarations of system functions, they fail if system does not support it */
+
+int   bisysopen (const char* path, const char* mode, size_t* size);
+int   bisysclose(int fd, size_t size, bool truncate);
+void* bisysmap  (int fd, size_t size, bool writable);
+void* bisysremap(int fd, void* data, size_t oldsize, size_t newsize);
+int   bisyssync (void* data, size_t size);
+void  bisysunmap(void* data, size_t size);
+
+/* reserved range of address space, its pages are committed on demand */
+void* bisysreserve (size_t size, bool hugepages);
+int   bisyscommit  (void* data, size_t size);
+void  bisysdecommit(void* data, size_t size);
+
+/* gives processor to other threads, does nothing without system support */
+void bisysyield(void);
+
+/* readv/writev with at most B_SYS_VEC_COUNT parts, EINTR is retried */
+#define B_SYS_VEC_COUNT 16
+
+long bisysreadv (int fd,       BUFVEC* vec, int count);
+long bisyswritev(int fd, const BUFVEC* vec, int count);
+
 /* Declarations of formatted io functions */
 
 int vbiscanf (BUFFER* buf, const char* fmt, va_list args);
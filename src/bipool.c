@@ -0,0 +1,244 @@
+#include <iobuffer/iobuffer.h>
+#include "bidefine.h"
+#include "biatomic.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define B_POOL_MIN_CAPACITY 1024
+#define B_POOL_CLASSES      15 /* up to 16 MiB */
+#define B_CACHE_DEPTH       8
+
+typedef struct bistack_t {
+    BUFFER** items;
+    size_t   count;
+    size_t   max;
+} bistack_t;
+
+struct BPOOL {
+    bilock_t  lock;
+    bistack_t classes[B_POOL_CLASSES]; /* class 'i' has buffers with capacity >= 1 KiB << i */
+    long      retained; /* capacity of buffers in classes and in caches, atomic */
+    size_t    maxretained;
+};
+
+/* owned by one thread, so its operations need no lock */
+struct BCACHE {
+    BPOOL*  pool;
+    BUFFER* items[B_POOL_CLASSES][B_CACHE_DEPTH];
+    int     count[B_POOL_CLASSES];
+};
+
+/* smallest class with enough capacity, B_POOL_CLASSES if there is none */
+static int biclassfor(size_t capacity) {
+    int cls = 0;
+    while (cls < B_POOL_CLASSES && ((size_t)B_POOL_MIN_CAPACITY << cls) < capacity) cls++;
+    return cls;
+}
+
+/* largest class which buffer with 'capacity' satisfies, -1 if there is none */
+static int biclassof(size_t capacity) {
+    int cls = -1;
+    if (capacity >= (size_t)B_POOL_MIN_CAPACITY << B_POOL_CLASSES) return -1;
+    while (cls + 1 < B_POOL_CLASSES && ((size_t)B_POOL_MIN_CAPACITY << (cls + 1)) <= capacity) cls++;
+    return cls;
+}
+
+/* capacity is counted when buffer is kept by pool or by cache,
+ * so caches take it without lock and the limit covers both */
+static int bicharge(BPOOL* pool, BUFFER* buf) {
+    size_t capacity = bicapacity(buf);
+    long old;
+    if (capacity > pool->maxretained) return B_FAIL;
+
+    old = biatomicadd(&pool->retained, (long)capacity);
+    if ((size_t)old + capacity > pool->maxretained) {
+        biatomicadd(&pool->retained, -(long)capacity);
+        return B_FAIL;
+    }
+    return B_OKEY;
+}
+
+/* buffer leaves pool and caches */
+static void birelease(BPOOL* pool, BUFFER* buf) {
+    biatomicadd(&pool->retained, -(long)bicapacity(buf));
+}
+
+/* pool must be locked, capacity of buffer is already counted */
+static int bipush(BPOOL* pool, int cls, BUFFER* buf) {
+    bistack_t* stack = &pool->classes[cls];
+
+    if (stack->count == stack->max) {
+        size_t newmax = stack->max ? stack->max * 2 : 16;
+        BUFFER** items = realloc(stack->items, newmax * sizeof *items);
+        if (!items) return B_FAIL;
+        stack->items = items;
+        stack->max = newmax;
+    }
+
+    stack->items[stack->count++] = buf;
+    return B_OKEY;
+}
+
+/* pool must be locked, capacity of buffer stays counted */
+static BUFFER* bipop(BPOOL* pool, int cls) {
+    bistack_t* stack = &pool->classes[cls];
+    if (stack->count == 0) return NULL;
+    return stack->items[--stack->count];
+}
+
+/* buffer already counted goes from cache to pool, closed if it is not kept */
+static int bispill(BPOOL* pool, int cls, BUFFER* buf) {
+    int rc;
+    bilock(&pool->lock);
+    rc = bipush(pool, cls, buf);
+    biunlock(&pool->lock);
+    if (rc == B_OKEY) return B_OKEY;
+
+    birelease(pool, buf);
+    return bclose(buf);
+}
+
+/* reopen recycled buffer or create new one with capacity of class */
+static BUFFER* biprepare(BUFFER* buf, int cls, size_t capacity, const char* mode) {
+    if (!buf) {
+        BOPTIONS opts;
+        memset(&opts, 0, sizeof opts);
+        opts.mode = "w";
+        opts.capacity = cls < B_POOL_CLASSES ? (size_t)B_POOL_MIN_CAPACITY << cls : capacity;
+        buf = bopenex(&opts);
+        if (!buf) return NULL;
+    }
+
+    if (bireuse(buf, mode)) {
+        bclose(buf);
+        return NULL;
+    }
+    return buf;
+}
+
+BPOOL* bpoolopen(size_t retain) {
+    BPOOL* pool = calloc(1, sizeof *pool);
+    if (!pool) return NULL;
+
+    pool->lock = B_LOCK_INIT;
+    /* counter is atomic 'long', half of its range is left for
+     * concurrent charges which are taken back */
+    pool->maxretained = retain < LONG_MAX / 2 ? retain : LONG_MAX / 2;
+    return pool;
+}
+
+void bpoolclose(BPOOL* pool) {
+    int cls; size_t i;
+    if (!pool) return;
+
+    for (cls = 0; cls < B_POOL_CLASSES; cls++) {
+        for (i = 0; i < pool->classes[cls].count; i++)
+            bclose(pool->classes[cls].items[i]);
+        free(pool->classes[cls].items);
+    }
+    free(pool);
+}
+
+BUFFER* bpoolget(BPOOL* restrict pool, size_t capacity, const char* restrict mode) {
+    BUFFER* buf = NULL; int cls;
+    /* invalid mode is rejected before pooled buffer is taken */
+    if (!pool || bireusemode(mode)) return NULL;
+
+    cls = biclassfor(capacity);
+    if (cls < B_POOL_CLASSES) {
+        bilock(&pool->lock);
+        buf = bipop(pool, cls);
+        biunlock(&pool->lock);
+        if (buf) birelease(pool, buf);
+    }
+
+    return biprepare(buf, cls, capacity, mode);
+}
+
+int bpoolput(BPOOL* restrict pool, BUFFER* restrict buf) {
+    int cls;
+    if (!pool || !buf) return EOB;
+    /* buffer in flight can be neither kept nor closed, caller keeps it */
+    if (biinflight(buf)) return EOB;
+
+    /* buffer without reusable storage is closed */
+    if (bireuse(buf, "w")) return bclose(buf);
+    cls = biclassof(bicapacity(buf));
+    if (cls < 0 || bicharge(pool, buf)) return bclose(buf);
+
+    return bispill(pool, cls, buf);
+}
+
+BCACHE* bcacheopen(BPOOL* pool) {
+    BCACHE* cache;
+    if (!pool) return NULL;
+
+    cache = calloc(1, sizeof *cache);
+    if (!cache) return NULL;
+
+    cache->pool = pool;
+    return cache;
+}
+
+void bcacheclose(BCACHE* cache) {
+    int cls;
+    if (!cache) return;
+
+    for (cls = 0; cls < B_POOL_CLASSES; cls++)
+        while (cache->count[cls] > 0)
+            bispill(cache->pool, cls, cache->items[cls][--cache->count[cls]]);
+    free(cache);
+}
+
+BUFFER* bcacheget(BCACHE* restrict cache, size_t capacity, const char* restrict mode) {
+    BUFFER* buf = NULL; BPOOL* pool; int cls;
+    if (!cache || bireusemode(mode)) return NULL;
+
+    cls = biclassfor(capacity);
+    if (cls < B_POOL_CLASSES) {
+        if (cache->count[cls] == 0) {
+            /* refill half of cache with one lock */
+            pool = cache->pool;
+            bilock(&pool->lock);
+            while (cache->count[cls] < B_CACHE_DEPTH / 2 && (buf = bipop(pool, cls)))
+                cache->items[cls][cache->count[cls]++] = buf;
+            biunlock(&pool->lock);
+        }
+        buf = cache->count[cls] > 0 ? cache->items[cls][--cache->count[cls]] : NULL;
+        if (buf) birelease(cache->pool, buf);
+    }
+
+    return biprepare(buf, cls, capacity, mode);
+}
+
+int bcacheput(BCACHE* restrict cache, BUFFER* restrict buf) {
+    BUFFER* spill[B_CACHE_DEPTH / 2]; BPOOL* pool; int cls, i, nspill = 0, rc = B_OKEY;
+    if (!cache || !buf) return EOB;
+    if (biinflight(buf)) return EOB;
+
+    if (bireuse(buf, "w")) return bclose(buf);
+    cls = biclassof(bicapacity(buf));
+    if (cls < 0 || bicharge(cache->pool, buf)) return bclose(buf);
+
+    if (cache->count[cls] == B_CACHE_DEPTH) {
+        /* move half of cache to pool with one lock */
+        pool = cache->pool;
+        bilock(&pool->lock);
+        while (cache->count[cls] > B_CACHE_DEPTH / 2) {
+            BUFFER* item = cache->items[cls][--cache->count[cls]];
+            if (bipush(pool, cls, item)) spill[nspill++] = item;
+        }
+        biunlock(&pool->lock);
+
+        /* buffers without place in pool are closed out of lock */
+        for (i = 0; i < nspill; i++) {
+            birelease(pool, spill[i]);
+            if (bclose(spill[i])) rc = EOB;
+        }
+    }
+
+    cache->items[cls][cache->count[cls]++] = buf;
+    return rc;
+}
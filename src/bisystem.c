@@ -0,0 +1,226 @@
+#if defined(__unix__) || defined(__APPLE__)
+#  define _GNU_SOURCE
+#  define B_SYS_POSIX
+#endif
+
+#include <iobuffer/iobuffer.h>
+#include "bidefine.h"
+
+#ifdef B_SYS_POSIX
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <sys/uio.h>
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <sched.h>
+#  include <unistd.h>
+#  ifndef MAP_ANONYMOUS
+#    define MAP_ANONYMOUS MAP_ANON
+#  endif
+#endif
+
+#ifdef B_SYS_POSIX
+
+int bisysopen(const char* path, const char* mode, size_t* size) {
+    struct stat st; int fd, flags;
+
+    /* mapping for writing needs reading access to file */
+    /**/ if (mode[0] == 'r') flags = mode[1] == '+' ? O_RDWR : O_RDONLY;
+    else if (mode[0] == 'w') flags = O_RDWR | O_CREAT | O_TRUNC;
+    else                     flags = O_RDWR | O_CREAT;
+
+    fd = open(path, flags, 0666);
+    if (fd < 0) return -1;
+
+    if (fstat(fd, &st) || (ullong)st.st_size > SIZE_MAX) {
+        close(fd);
+        return -1;
+    }
+
+    *size = (size_t)st.st_size;
+    return fd;
+}
+
+int bisysclose(int fd, size_t size, bool truncate) {
+    int rc = B_OKEY;
+    if (truncate && ftruncate(fd, (off_t)size)) rc = B_FAIL;
+    if (close(fd)) rc = B_FAIL;
+    return rc;
+}
+
+void* bisysmap(int fd, size_t size, bool writable) {
+    void* data;
+    if (size == 0) return NULL;
+
+    data = writable
+        ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED , fd, 0)
+        : mmap(NULL, size, PROT_READ             , MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) return NULL;
+
+#ifdef MADV_SEQUENTIAL
+    if (!writable) madvise(data, size, MADV_SEQUENTIAL);
+#endif
+
+    return data;
+}
+
+void* bisysremap(int fd, void* data, size_t oldsize, size_t newsize) {
+    if (ftruncate(fd, (off_t)newsize)) return NULL;
+    if (!data) return bisysmap(fd, newsize, true);
+
+#ifdef MREMAP_MAYMOVE
+    data = mremap(data, oldsize, newsize, MREMAP_MAYMOVE);
+    return data == MAP_FAILED ? NULL : data;
+#else
+    /* content lives in file, so mapping it again keeps it */
+    {
+        void* newdata = bisysmap(fd, newsize, true);
+        if (newdata) munmap(data, oldsize);
+        return newdata;
+    }
+#endif
+}
+
+int bisyssync(void* data, size_t size) {
+    if (!data || size == 0) return B_OKEY;
+    return msync(data, size, MS_SYNC) ? B_FAIL : B_OKEY;
+}
+
+void bisysunmap(void* data, size_t size) {
+    if (data) munmap(data, size);
+}
+
+void* bisysreserve(size_t size, bool hugepages) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS; void* data;
+
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+
+    /* range is not accessible until its pages are committed */
+    data = mmap(NULL, size, PROT_NONE, flags, -1, 0);
+    if (data == MAP_FAILED) return NULL;
+
+#ifdef MADV_HUGEPAGE
+    if (hugepages) madvise(data, size, MADV_HUGEPAGE);
+#else
+    (void)hugepages;
+#endif
+
+    return data;
+}
+
+int bisyscommit(void* data, size_t size) {
+    if (size == 0) return B_OKEY;
+    return mprotect(data, size, PROT_READ | PROT_WRITE) ? B_FAIL : B_OKEY;
+}
+
+void bisysdecommit(void* data, size_t size) {
+    if (size == 0) return;
+    /* anonymous pages are zero when they are committed again */
+    madvise(data, size, MADV_DONTNEED);
+    mprotect(data, size, PROT_NONE);
+}
+
+void bisysyield(void) {
+    sched_yield();
+}
+
+long bisysreadv(int fd, BUFVEC* vec, int count) {
+    struct iovec iov[B_SYS_VEC_COUNT]; ssize_t got; int i;
+
+    for (i = 0; i < count; i++) {
+        iov[i].iov_base = vec[i].base;
+        iov[i].iov_len  = vec[i].size;
+    }
+
+    do got = readv(fd, iov, count);
+    while (got < 0 && errno == EINTR);
+    return got;
+}
+
+long bisyswritev(int fd, const BUFVEC* vec, int count) {
+    struct iovec iov[B_SYS_VEC_COUNT], *cur = iov; ssize_t got; long total = 0;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        iov[i].iov_base = vec[i].base;
+        iov[i].iov_len  = vec[i].size;
+    }
+
+    /* short writes are continued until everything is written or fd would block */
+    while (count > 0) {
+        got = writev(fd, cur, count);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return total ? total : (long)got;
+        total += got;
+
+        for (; count > 0 && (size_t)got >= cur->iov_len; cur++, count--)
+            got -= cur->iov_len;
+        if (count > 0) {
+            cur->iov_base  = (char*)cur->iov_base + got;
+            cur->iov_len  -= got;
+        }
+    }
+
+    return total;
+}
+
+#else /* B_SYS_POSIX */
+
+int bisysopen(const char* path, const char* mode, size_t* size) {
+    (void)path; (void)mode; (void)size;
+    return -1;
+}
+
+int bisysclose(int fd, size_t size, bool truncate) {
+    (void)fd; (void)size; (void)truncate;
+    return B_FAIL;
+}
+
+void* bisysmap(int fd, size_t size, bool writable) {
+    (void)fd; (void)size; (void)writable;
+    return NULL;
+}
+
+void* bisysremap(int fd, void* data, size_t oldsize, size_t newsize) {
+    (void)fd; (void)data; (void)oldsize; (void)newsize;
+    return NULL;
+}
+
+int bisyssync(void* data, size_t size) {
+    (void)data; (void)size;
+    return B_FAIL;
+}
+
+void bisysunmap(void* data, size_t size) {
+    (void)data; (void)size;
+}
+
+void* bisysreserve(size_t size, bool hugepages) {
+    (void)size; (void)hugepages;
+    return NULL;
+}
+
+int bisyscommit(void* data, size_t size) {
+    (void)data; (void)size;
+    return B_FAIL;
+}
+
+void bisysdecommit(void* data, size_t size) {
+    (void)data; (void)size;
+}
+
+void bisysyield(void) {}
+
+long bisysreadv(int fd, BUFVEC* vec, int count) {
+    (void)fd; (void)vec; (void)count;
+    return -1;
+}
+
+long bisyswritev(int fd, const BUFVEC* vec, int count) {
+    (void)fd; (void)vec; (void)count;
+    return -1;
+}
+
+#endif /* B_SYS_POSIX */
@@ -0,0 +1,383 @@
+#define _GNU_SOURCE
+
+#include <iobuffer/iouring.h>
+#include "bidefine.h"
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/* registered buffer, table is sorted by address for search */
+typedef struct bireg_t {
+    BUFFER* buf;
+    int     index;
+} bireg_t;
+
+/* operation in flight, its index is user_data of entry */
+typedef struct biop_t {
+    BUFFER* buf;
+    void*   udata;
+    struct iovec iov; /* must live until entry is submitted */
+    bool    drain;
+    int     next; /* free list */
+} biop_t;
+
+struct BURING {
+    int fd;
+
+    void*  sqring; size_t sqsize;
+    void*  cqring; size_t cqsize;
+    struct io_uring_sqe* sqes; size_t sqessize;
+
+    unsigned *sqhead, *sqtail, *sqmask, *sqarray;
+    unsigned *cqhead, *cqtail, *cqmask;
+    struct io_uring_cqe* cqes;
+    unsigned sqentries;
+    unsigned pending; /* entries after last submit */
+
+    biop_t*  ops;
+    unsigned nops;
+    int      freeop;
+
+    bireg_t* registered;
+    unsigned nregistered;
+
+    balloc_t alloc; /* allocator at opening, used for all objects of ring */
+    void*    udata;
+};
+
+/* limit of bytes for one read or write in Linux */
+#define B_URING_MAX_LEN 0x7ffff000u
+
+/* user_data of cancel entries, indices of operations are less */
+#define B_URING_CANCEL ((unsigned long long)-1)
+
+/* head and tail are shared with kernel */
+#define B_LOAD_ACQ(ptr)     __atomic_load_n ((ptr),      __ATOMIC_ACQUIRE)
+#define B_STORE_REL(ptr, v) __atomic_store_n((ptr), (v), __ATOMIC_RELEASE)
+
+static int bisetup(unsigned entries, struct io_uring_params* params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int bienter(int fd, unsigned submit, unsigned wait, unsigned flags) {
+    int rc;
+    do rc = (int)syscall(__NR_io_uring_enter, fd, submit, wait, flags, NULL, 0);
+    while (rc < 0 && errno == EINTR);
+    return rc;
+}
+
+static void* bimapring(int fd, size_t size, long long offset) {
+    void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, fd, offset);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+/* zeroed array by allocator of library */
+static void* bizeroed(balloc_t alloc, void* udata, size_t count, size_t size) {
+    void* ptr;
+    if (count > SIZE_MAX / size) return NULL;
+    ptr = alloc(NULL, count * size, udata);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+static void biunmapring(BURING* ring) {
+    if (ring->sqring) munmap(ring->sqring, ring->sqsize);
+    if (ring->cqring) munmap(ring->cqring, ring->cqsize);
+    if (ring->sqes  ) munmap(ring->sqes  , ring->sqessize);
+}
+
+BURING* buropen(unsigned entries) {
+    struct io_uring_params params; BURING* ring; unsigned i;
+    balloc_t alloc; void* udata;
+    if (entries == 0) return NULL;
+
+    bicurrentalloc(&alloc, &udata);
+    ring = bizeroed(alloc, udata, 1, sizeof *ring);
+    if (!ring) return NULL;
+    ring->alloc = alloc;
+    ring->udata = udata;
+
+    memset(&params, 0, sizeof params);
+    ring->fd = bisetup(entries, &params);
+    if (ring->fd < 0) goto failed;
+
+    ring->sqsize   = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqsize   = params.cq_off.cqes  + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqessize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sqring = bimapring(ring->fd, ring->sqsize  , IORING_OFF_SQ_RING);
+    ring->cqring = bimapring(ring->fd, ring->cqsize  , IORING_OFF_CQ_RING);
+    ring->sqes   = bimapring(ring->fd, ring->sqessize, IORING_OFF_SQES);
+    if (!ring->sqring || !ring->cqring || !ring->sqes) goto failed;
+
+    ring->sqhead  = (unsigned*)((char*)ring->sqring + params.sq_off.head);
+    ring->sqtail  = (unsigned*)((char*)ring->sqring + params.sq_off.tail);
+    ring->sqmask  = (unsigned*)((char*)ring->sqring + params.sq_off.ring_mask);
+    ring->sqarray = (unsigned*)((char*)ring->sqring + params.sq_off.array);
+    ring->cqhead  = (unsigned*)((char*)ring->cqring + params.cq_off.head);
+    ring->cqtail  = (unsigned*)((char*)ring->cqring + params.cq_off.tail);
+    ring->cqmask  = (unsigned*)((char*)ring->cqring + params.cq_off.ring_mask);
+    ring->cqes    = (struct io_uring_cqe*)((char*)ring->cqring + params.cq_off.cqes);
+    ring->sqentries = params.sq_entries;
+
+    /* operations are limited by completion queue, so it never overflows */
+    ring->ops = bizeroed(ring->alloc, ring->udata, params.cq_entries, sizeof *ring->ops);
+    if (!ring->ops) goto failed;
+    ring->nops = params.cq_entries;
+    for (i = 0; i < params.cq_entries; i++)
+        ring->ops[i].next = i + 1 < params.cq_entries ? (int)i + 1 : -1;
+
+    return ring;
+
+failed:
+    burclose(ring);
+    return NULL;
+}
+
+static int bicmpreg(const void* lhs, const void* rhs) {
+    const BUFFER* l = ((const bireg_t*)lhs)->buf;
+    const BUFFER* r = ((const bireg_t*)rhs)->buf;
+    return (l > r) - (l < r);
+}
+
+int burregister(BURING* restrict ring, BUFFER* const* restrict bufs, unsigned count) {
+    struct iovec* iovs; unsigned i; int rc;
+    if (!ring || !bufs || count == 0 || ring->registered) return B_FAIL;
+
+    iovs = bizeroed(ring->alloc, ring->udata, count, sizeof *iovs);
+    ring->registered = bizeroed(ring->alloc, ring->udata, count, sizeof *ring->registered);
+    if (!iovs || !ring->registered) goto failed;
+
+    /* only storage of fixed buffers never moves */
+    for (i = 0; i < count; i++) {
+        if (!bufs[i]) goto failed;
+        iovs[i].iov_base = bifixedstorage(bufs[i], &iovs[i].iov_len);
+        if (!iovs[i].iov_base) goto failed;
+        ring->registered[i].buf   = bufs[i];
+        ring->registered[i].index = (int)i;
+    }
+
+    rc = (int)syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, iovs, count);
+    if (rc < 0) goto failed;
+
+    ring->nregistered = count;
+    qsort(ring->registered, count, sizeof *ring->registered, bicmpreg);
+    ring->alloc(iovs, 0, ring->udata);
+    return B_OKEY;
+
+failed:
+    if (ring->registered) ring->alloc(ring->registered, 0, ring->udata);
+    ring->registered = NULL;
+    if (iovs) ring->alloc(iovs, 0, ring->udata);
+    return B_FAIL;
+}
+
+static int biregindex(BURING* ring, BUFFER* buf) {
+    bireg_t key, *found;
+    if (ring->nregistered == 0) return -1;
+
+    key.buf = buf;
+    found = bsearch(&key, ring->registered, ring->nregistered,
+        sizeof *ring->registered, bicmpreg);
+    return found ? found->index : -1;
+}
+
+/* zeroed entry queued for next submit, full queue is submitted first */
+static struct io_uring_sqe* binextsqe(BURING* ring) {
+    struct io_uring_sqe* sqe; unsigned tail, index;
+
+    tail = *ring->sqtail;
+    if (tail - B_LOAD_ACQ(ring->sqhead) == ring->sqentries) {
+        if (bienter(ring->fd, ring->pending, 0, 0) < 0) return NULL;
+        ring->pending = 0;
+        if (tail - B_LOAD_ACQ(ring->sqhead) == ring->sqentries) return NULL;
+    }
+
+    index = tail & *ring->sqmask;
+    sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof *sqe);
+
+    ring->sqarray[index] = index;
+    B_STORE_REL(ring->sqtail, tail + 1);
+    ring->pending++;
+    return sqe;
+}
+
+static int bisubmit(BURING* ring, int op, int fd) {
+    struct io_uring_sqe* sqe; int reg;
+    biop_t* bop = &ring->ops[op];
+
+    sqe = binextsqe(ring);
+    if (!sqe) return B_FAIL;
+
+    reg = biregindex(ring, bop->buf);
+    if (reg >= 0) {
+        sqe->opcode    = bop->drain ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->addr      = (unsigned long)bop->iov.iov_base;
+        sqe->len       = bop->iov.iov_len;
+        sqe->buf_index = reg;
+    } else {
+        sqe->opcode    = bop->drain ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->addr      = (unsigned long)&bop->iov;
+        sqe->len       = 1;
+    }
+    sqe->fd        = fd;
+    sqe->off       = (unsigned long long)-1; /* current position of file */
+    sqe->user_data = op;
+    return B_OKEY;
+}
+
+static int biallocop(BURING* ring, BUFFER* buf, void* udata, bool drain) {
+    int op = ring->freeop;
+    if (op < 0) return -1;
+
+    ring->freeop = ring->ops[op].next;
+    bimarkio(buf, true);
+    ring->ops[op].buf   = buf;
+    ring->ops[op].udata = udata;
+    ring->ops[op].drain = drain;
+    return op;
+}
+
+static void bifreeop(BURING* ring, int op) {
+    bimarkio(ring->ops[op].buf, false);
+    ring->ops[op].buf  = NULL;
+    ring->ops[op].next = ring->freeop;
+    ring->freeop = op;
+}
+
+/* cancel operations in flight and reap their completions,
+ * kernel uses storage of buffers until then */
+static int bicancelall(BURING* ring) {
+    struct io_uring_sqe* sqe; struct io_uring_cqe* cqe;
+    unsigned i, head, left = 0;
+
+    for (i = 0; ring->ops && i < ring->nops; i++) {
+        if (!ring->ops[i].buf) continue;
+        left++;
+        sqe = binextsqe(ring);
+        if (!sqe) return B_FAIL;
+        sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+        sqe->addr      = i;
+        sqe->user_data = B_URING_CANCEL;
+    }
+
+    while (left > 0) {
+        if (bienter(ring->fd, ring->pending, 1, IORING_ENTER_GETEVENTS) < 0) return B_FAIL;
+        ring->pending = 0;
+
+        for (head = *ring->cqhead; head != B_LOAD_ACQ(ring->cqtail); head++) {
+            biop_t* bop;
+            cqe = &ring->cqes[head & *ring->cqmask];
+            if (cqe->user_data == B_URING_CANCEL) continue;
+
+            /* bytes transferred before cancelling are kept as by burwait */
+            bop = &ring->ops[cqe->user_data];
+            if (cqe->res > 0) {
+                if (bop->drain) biconsume(bop->buf, cqe->res);
+                else            biappend (bop->buf, cqe->res);
+            }
+            bifreeop(ring, (int)cqe->user_data);
+            left--;
+        }
+        B_STORE_REL(ring->cqhead, head);
+    }
+    return B_OKEY;
+}
+
+int burclose(BURING* ring) {
+    int rc = B_OKEY;
+    if (!ring) return EOB;
+    /* ring is kept while kernel may use storage of buffers */
+    if (bicancelall(ring)) return EOB;
+
+    biunmapring(ring);
+    if (ring->fd >= 0 && close(ring->fd)) rc = B_FAIL;
+
+    if (ring->registered) ring->alloc(ring->registered, 0, ring->udata);
+    if (ring->ops) ring->alloc(ring->ops, 0, ring->udata);
+    ring->alloc(ring, 0, ring->udata);
+    return rc ? EOB : B_OKEY;
+}
+
+int burfill(BURING* ring, BUFFER* buf, int fd, size_t max, void* udata) {
+    void* ptr; size_t len; int op;
+    if (!ring || !buf) return B_FAIL;
+    /* second operation would use storage of first one */
+    if (biinflight(buf)) return B_FAIL;
+
+    ptr = bispare(buf, max < B_URING_MAX_LEN ? max : B_URING_MAX_LEN, &len);
+    if (!ptr) return B_FAIL;
+
+    op = biallocop(ring, buf, udata, false);
+    if (op < 0) return B_FAIL;
+    ring->ops[op].iov.iov_base = ptr;
+    ring->ops[op].iov.iov_len  = len;
+
+    if (bisubmit(ring, op, fd)) {
+        bifreeop(ring, op);
+        return B_FAIL;
+    }
+    return B_OKEY;
+}
+
+int burdrain(BURING* ring, BUFFER* buf, int fd, void* udata) {
+    const void* ptr; size_t len; int op;
+    if (!ring || !buf) return B_FAIL;
+    if (biinflight(buf)) return B_FAIL;
+
+    ptr = bpeekspan(buf, &len);
+    if (!ptr || len == 0) return B_FAIL;
+
+    op = biallocop(ring, buf, udata, true);
+    if (op < 0) return B_FAIL;
+    ring->ops[op].iov.iov_base = (void*)ptr;
+    ring->ops[op].iov.iov_len  = len < B_URING_MAX_LEN ? len : B_URING_MAX_LEN;
+
+    if (bisubmit(ring, op, fd)) {
+        bifreeop(ring, op);
+        return B_FAIL;
+    }
+    return B_OKEY;
+}
+
+int burwait(BURING* restrict ring, BUREVENT* restrict events, int count, int minimum) {
+    struct io_uring_cqe* cqe; unsigned head; int done = 0;
+    if (!ring || (!events && count > 0) || count < minimum) return EOB;
+
+    if (ring->pending || minimum > 0) {
+        if (bienter(ring->fd, ring->pending, minimum > 0 ? minimum : 0,
+            minimum > 0 ? IORING_ENTER_GETEVENTS : 0) < 0) return EOB;
+        ring->pending = 0;
+    }
+
+    for (head = *ring->cqhead; done < count && head != B_LOAD_ACQ(ring->cqtail); head++) {
+        biop_t* bop;
+        cqe = &ring->cqes[head & *ring->cqmask];
+        bop = &ring->ops[cqe->user_data];
+
+        /* result is applied to buffer as by bfillfd and bdrainfd */
+        if (cqe->res > 0) {
+            if (bop->drain) biconsume(bop->buf, cqe->res);
+            else            biappend (bop->buf, cqe->res);
+        }
+
+        events[done].buffer   = bop->buf;
+        events[done].userdata = bop->udata;
+        events[done].result   = cqe->res;
+        events[done].drain    = bop->drain;
+        done++;
+
+        bifreeop(ring, (int)cqe->user_data);
+    }
+    B_STORE_REL(ring->cqhead, head);
+
+    return done;
+}
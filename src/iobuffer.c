@@ -1,24 +1,91 @@
 #include <iobuffer/iobuffer.h>
 #include "bidefine.h"
+#include "biatomic.h"
 
 #include <stdlib.h>
 #include <string.h>
 
 #define B_INIT_CAPACITY 1024
+#define B_CHUNK_CAPACITY 65536
+#define B_GROWTH_DEFAULT 207 /* phi ~ 207/128 */
+#define B_COMMIT_STEP 65536
+#define B_SCRATCH_CAPACITY 256
+
+/* storage of frozen buffer shared by its clones */
+typedef struct bishared_t {
+    long     refs;
+    uchar*   storage;
+    balloc_t alloc;
+    void*    udata;
+} bishared_t;
 
 struct BUFFER {
     uchar* data;
     size_t count;
     size_t capacity;
     bpos_t cursor;
+    size_t shift; /* bytes dropped before data in queue mode */
+    size_t gappos; /* gap mode: gap starts at this position */
+    size_t gaplen; /* gap mode: count of unused bytes in gap */
+    size_t dirty; /* bytes of storage which may keep erased content, wiped by bresetex */
+
+    uchar** chunks; /* segmented mode: blocks with B_CHUNK_CAPACITY bytes */
+    size_t nchunks;
+    size_t maxchunks;
+    uchar*  spare; /* segmented mode: block for direct write over end of block */
 
     balloc_t alloc;
     void*    udata;
+    size_t   initcap; /* first allocation, zero for B_INIT_CAPACITY */
+    size_t   growth;  /* factor of growth in 1/128, zero for B_GROWTH_DEFAULT */
+    size_t   threshold; /* capacity from which growth is linear by step */
+    size_t   step;      /* zero for geometric growth only */
+    bool     exact;     /* capacity is equal to required */
+
+    int fd; /* file of mapped storage */
+    size_t reserved; /* reserved mode: size of address range, zero for others */
+    bishared_t* shared; /* frozen storage, it is copied before change */
+
+    /* ring mode: buffer itself is neither readable nor writable,
+     * reader and writer threads use own views of its storage */
+    struct BUFFER* sides; /* views of reader and writer */
+    long  ringhead; /* reader view: count of read bytes, changed by reader only */
+    long  ringtail; /* writer view: count of written bytes, changed by writer only */
+    ulong ringbase; /* view: index of its first byte in ring */
+    ulong ringmask; /* view: capacity - 1, zero for other buffers */
+
+    /* concurrent append mode: writers reserve bytes by atomic addition
+     * and publish them in order of reservation, readers lock the view */
+    long appreserved;  /* end of reserved bytes */
+    long apppublished; /* end of complete bytes visible to readers */
+    long appcapacity;  /* capacity of view for writers without lock */
+    long appwriters;   /* count of writers copying into storage */
+    long appfailed;    /* start of reservation without storage, LONG_MAX for none */
+    bilock_t applock;  /* taken by readers and by growth of storage */
+
+    bilock_t lock; /* taken by block or by functions of locked buffer */
+
+    bsink_t sink; /* receiver of content instead of growth over limit */
+    void*   sinkdata;
+    size_t  sinklimit;
+
+    bsource_t source; /* supplier of content after the end is read */
+    void*     sourcedata;
 
     bool readable;
     bool writable;
     bool allocated;
     bool fixed;
+    bool queue;
+    bool gapped;
+    bool segmented;
+    bool spared; /* last bwritebegin returned spare block */
+    bool borrowed; /* storage is read-only and is never written */
+    bool mapped;
+    bool ring;
+    bool concurrent;
+    bool locked; /* functions of standard input/output take the lock */
+    bool inflight; /* storage is used by kernel until completion */
 };
 
 static size_t bimin(size_t a, size_t b) { return a < b ? a : b; }
@@ -33,33 +100,338 @@ static void* bidfltalloc(void* ptr, size_t size, void* ud) {
 static balloc_t bialloc = bidfltalloc; /* current allocator function */
 static void*    biudata = NULL;        /* userdata for that */
 
+static uchar* bistorage(BUFFER* buf) {
+    return buf->shift ? buf->data - buf->shift : buf->data;
+}
+
+/* remember used part of storage before content is moved or shortened,
+ * bytes left after content are wiped by bresetex */
+static void bimarkdirty(BUFFER* buf) {
+    buf->dirty = bimax(buf->dirty, buf->shift + buf->count + buf->gaplen);
+}
+
+/* move content back to the start of storage, dropped prefix becomes free */
+static void bicompact(BUFFER* buf) {
+    if (buf->shift == 0) return;
+    bimarkdirty(buf);
+    memmove(bistorage(buf), buf->data, buf->count);
+    buf->data     -= buf->shift;
+    buf->capacity += buf->shift;
+    buf->shift = 0;
+}
+
+/* pointer to byte at position, position must be less than capacity */
+static uchar* biat(BUFFER* buf, size_t pos) {
+    if (buf->ringmask) return buf->data + ((buf->ringbase + pos) & buf->ringmask);
+    if (!buf->segmented) return buf->data + pos;
+    return buf->chunks[pos / B_CHUNK_CAPACITY] + pos % B_CHUNK_CAPACITY;
+}
+
+/* pointer to byte at position and count of bytes after it in the same block */
+static uchar* bispan(BUFFER* buf, size_t pos, size_t* len) {
+    if (buf->ringmask) {
+        /* span ends at the end of storage or of view */
+        size_t at = (buf->ringbase + pos) & buf->ringmask;
+        *len = pos < buf->capacity ? bimin(buf->capacity - pos, buf->capacity - at) : 0;
+        return buf->data + at;
+    }
+    if (pos >= buf->capacity) {
+        *len = 0;
+        if (!buf->segmented || !buf->nchunks) return buf->data + pos;
+        return buf->chunks[buf->nchunks - 1] + B_CHUNK_CAPACITY;
+    }
+    *len = buf->segmented
+        ? B_CHUNK_CAPACITY - pos % B_CHUNK_CAPACITY
+        : buf->capacity - pos;
+    return biat(buf, pos);
+}
+
+static void bistore(BUFFER* buf, size_t pos, const void* src, size_t len) {
+    const uchar* from = src; size_t step;
+    if (!buf->segmented && !buf->ringmask) {
+        memcpy(buf->data + pos, src, len);
+        return;
+    }
+    for (; len > 0; pos += step, from += step, len -= step) {
+        uchar* span = bispan(buf, pos, &step);
+        memcpy(span, from, step = bimin(step, len));
+    }
+}
+
+static void biload(BUFFER* buf, size_t pos, void* dst, size_t len) {
+    uchar* to = dst; size_t step;
+    if (!buf->segmented && !buf->ringmask) {
+        memcpy(dst, buf->data + pos, len);
+        return;
+    }
+    for (; len > 0; pos += step, to += step, len -= step) {
+        uchar* span = bispan(buf, pos, &step);
+        memcpy(to, span, step = bimin(step, len));
+    }
+}
+
+static void bifill(BUFFER* buf, size_t pos, int ch, size_t len) {
+    size_t step;
+    if (!buf->segmented && !buf->ringmask) {
+        memset(buf->data + pos, ch, len);
+        return;
+    }
+    for (; len > 0; pos += step, len -= step) {
+        uchar* span = bispan(buf, pos, &step);
+        memset(span, ch, step = bimin(step, len));
+    }
+}
+
+/* memset through volatile pointer is not removed as dead store */
+static void* (*volatile bimemset)(void*, int, size_t) = memset;
+
+/* zero used part of storage, unused capacity is not touched */
+static void biwipe(BUFFER* buf) {
+    size_t i, len;
+    bimarkdirty(buf);
+    len = bimin(buf->dirty, buf->shift + buf->capacity);
+    buf->dirty = 0;
+    if (!buf->segmented) {
+        if (len) bimemset(bistorage(buf), 0, len);
+        return;
+    }
+    for (i = 0; i * B_CHUNK_CAPACITY < len; i++)
+        bimemset(buf->chunks[i], 0, bimin(len - i * B_CHUNK_CAPACITY, B_CHUNK_CAPACITY));
+    /* committed bytes stay in spare block after copying */
+    if (buf->spare) bimemset(buf->spare, 0, B_CHUNK_CAPACITY);
+}
+
+/* move bytes inside of buffer, ranges may overlap */
+static void bimovewithin(BUFFER* buf, size_t dst, size_t src, size_t len) {
+    size_t dstep, sstep, step;
+    if (!buf->segmented) {
+        memmove(buf->data + dst, buf->data + src, len);
+        return;
+    }
+    if (dst <= src)
+        for (; len > 0; dst += step, src += step, len -= step) {
+            uchar* to   = bispan(buf, dst, &dstep);
+            uchar* from = bispan(buf, src, &sstep);
+            memmove(to, from, step = bimin(len, bimin(dstep, sstep)));
+        }
+    else
+        /* copy backward by pieces which end at block boundaries */
+        for (; len > 0; len -= step) {
+            dstep = (dst + len - 1) % B_CHUNK_CAPACITY + 1;
+            sstep = (src + len - 1) % B_CHUNK_CAPACITY + 1;
+            step = bimin(len, bimin(dstep, sstep));
+            memmove(biat(buf, dst + len - step), biat(buf, src + len - step), step);
+        }
+}
+
+/* segmented growth appends blocks, written content never moves */
+static int birequirechunks(BUFFER* buf, size_t require) {
+    while (buf->cursor + require > buf->capacity) {
+        uchar* chunk;
+        if (buf->nchunks == buf->maxchunks) {
+            size_t newmax = buf->maxchunks ? buf->maxchunks * 2 : 8;
+            uchar** newlist = buf->alloc(buf->chunks, newmax * sizeof *newlist, buf->udata);
+            if (!newlist) return B_FAIL;
+            buf->chunks = newlist;
+            buf->maxchunks = newmax;
+        }
+
+        chunk = buf->alloc(NULL, B_CHUNK_CAPACITY, buf->udata);
+        if (!chunk) return B_FAIL;
+
+        buf->chunks[buf->nchunks++] = chunk;
+        buf->capacity += B_CHUNK_CAPACITY;
+        buf->data = buf->chunks[0];
+    }
+    return B_OKEY;
+}
+
+static void bifreechunks(BUFFER* buf) {
+    while (buf->nchunks > 0)
+        buf->alloc(buf->chunks[--buf->nchunks], 0, buf->udata);
+    buf->alloc(buf->chunks, 0, buf->udata);
+    if (buf->spare) buf->alloc(buf->spare, 0, buf->udata);
+}
+
+static void birelease(bishared_t* shared) {
+    if (biatomicadd(&shared->refs, -1) != 1) return;
+    shared->alloc(shared->storage, 0, shared->udata);
+    shared->alloc(shared, 0, shared->udata);
+}
+
+/* give buffer own storage before the shared one is changed */
+static int biunshare(BUFFER* buf) {
+    bishared_t* shared = buf->shared; uchar* storage;
+
+    if (biatomicload(&shared->refs) == 1 && shared->alloc == buf->alloc && shared->udata == buf->udata) {
+        /* the last owner takes storage without copying */
+        buf->alloc(shared, 0, buf->udata);
+    } else {
+        storage = buf->alloc(NULL, bimax(buf->count, 1), buf->udata);
+        if (!storage) return B_FAIL;
+        memcpy(storage, buf->data, buf->count);
+        birelease(shared);
+
+        buf->data     = storage;
+        buf->capacity = bimax(buf->count, 1);
+        buf->shift    = 0;
+    }
+
+    buf->shared = NULL;
+    buf->allocated = true;
+    return B_OKEY;
+}
+
+static void bidrop(BUFFER* buf, size_t size) {
+    bimarkdirty(buf);
+    memmove(buf->data, buf->data + size, buf->count - size);
+    buf->count  -= size;
+    buf->cursor -= bimin(buf->cursor, size);
+}
+
+/* pass first bytes of content to sink and remove them */
+static int biflush(BUFFER* buf, size_t size) {
+    if (size == 0) return B_OKEY;
+    if (buf->sink(buf->data, size, buf->sinkdata)) return B_FAIL;
+    bidrop(buf, size);
+    return B_OKEY;
+}
+
+static size_t biroundcommit(size_t size) {
+    return (size + B_COMMIT_STEP - 1) / B_COMMIT_STEP * B_COMMIT_STEP;
+}
+
+/* new capacity of storage for 'need' bytes by growth policy of buffer */
+static size_t binewcap(BUFFER* buf, size_t need) {
+    size_t newcap = buf->shift + buf->capacity, factor;
+    if (buf->exact) return newcap == 0 ? bimax(need, buf->initcap) : need;
+
+    if (newcap == 0) newcap = buf->initcap ? buf->initcap : B_INIT_CAPACITY;
+    factor = buf->growth ? buf->growth : B_GROWTH_DEFAULT;
+    while (need > newcap) {
+        if (buf->step && newcap >= buf->threshold)
+            /* linear growth by whole steps over the threshold */
+            return newcap + (need - newcap + buf->step - 1) / buf->step * buf->step;
+        if (newcap > SIZE_MAX / factor) return need;
+        /* growth by law 'new = ceil(old * factor)', phi by default */
+        newcap = (newcap * factor + 127) / 128;
+    }
+    return newcap;
+}
+
+/* storage can not be written in place, it is used by kernel
+ * or still shared with clones after failed copying */
+static bool bipinned(BUFFER* buf) {
+    return buf->inflight || buf->shared;
+}
+
 static int birequire(BUFFER* buf, size_t require) {
-    size_t newcap = buf->capacity; void* newplace;
-    if (buf->cursor + require <= newcap) return B_OKEY;
+    size_t newcap; uchar* newplace;
+    /* storage used by kernel is neither written, moved nor flushed */
+    if (buf->inflight) return B_FAIL;
+    if (buf->shared && biunshare(buf)) return B_FAIL;
+    if (buf->cursor + require <= buf->capacity)
+        if (!buf->sink || buf->cursor + require <= buf->sinklimit) return B_OKEY;
+
+    /* sink takes written prefix instead of growth over the limit */
+    if (buf->sink && (buf->fixed || buf->cursor + require > buf->sinklimit)) {
+        if (biflush(buf, buf->cursor)) return B_FAIL;
+        if (buf->cursor + require <= buf->capacity) return B_OKEY;
+    }
+    if (buf->segmented) return birequirechunks(buf, require);
+
+    /* dropped prefix is reused only when it is not less than content,
+     * so moving is paid by previously erased bytes */
+    if (buf->fixed || buf->shift >= buf->count) bicompact(buf);
+    if (buf->cursor + require <= buf->capacity) return B_OKEY;
     if (buf->fixed) return B_FAIL;
 
-    if (newcap == 0) newcap = B_INIT_CAPACITY;
-    while (buf->cursor + require > newcap)
-        /* growth by law 'new = ceil(old * phi)', phi ~ 207/128 */
-        newcap = (newcap * 207 + 127) / 128;
+    newcap = binewcap(buf, buf->shift + buf->cursor + require);
+    if (buf->reserved) {
+        /* storage never moves, only pages of its range are committed */
+        if (buf->shift + buf->cursor + require > buf->reserved) return B_FAIL;
+        newcap = bimin(biroundcommit(newcap), buf->reserved);
+        if (bisyscommit(bistorage(buf) + buf->shift + buf->capacity,
+                newcap - buf->shift - buf->capacity)) return B_FAIL;
+        buf->capacity = newcap - buf->shift;
+        return B_OKEY;
+    }
 
-    newplace = buf->alloc(buf->data, newcap, buf->udata);
+    newplace = buf->mapped
+        ? bisysremap(buf->fd, buf->data, buf->capacity, newcap)
+        : buf->alloc(bistorage(buf), newcap, buf->udata);
     if (!newplace) return B_FAIL;
 
-    buf->data = newplace;
-    buf->capacity = newcap;
+    buf->data = newplace + buf->shift;
+    buf->capacity = newcap - buf->shift;
+    return B_OKEY;
+}
+
+/* read content from source until 'require' bytes are after position,
+ * read bytes are dropped, so the window grows only for longer requests */
+static int birefill(BUFFER* buf, size_t require) {
+    size_t got;
+    if (!buf->source) return B_FAIL;
+
+    while (buf->count - buf->cursor < require) {
+        if (buf->cursor) bidrop(buf, buf->cursor);
+        if (birequire(buf, bimax(require, buf->count + 1)) && buf->count == buf->capacity)
+            return B_FAIL;
+
+        got = buf->source(buf->data + buf->count, buf->capacity - buf->count, buf->sourcedata);
+        if (got == 0) return B_FAIL;
+        buf->count += bimin(got, buf->capacity - buf->count);
+    }
+
     return B_OKEY;
 }
 
+/* remove gap from the content, it becomes contiguous again */
+static void biclosegap(BUFFER* buf) {
+    if (buf->gaplen == 0) return;
+    bimarkdirty(buf);
+    memmove(buf->data  + buf->gappos,
+            buf->data  + buf->gappos + buf->gaplen,
+            buf->count - buf->gappos);
+    buf->gaplen = 0;
+}
+
+/* place gap to the current position, its moving costs the distance only */
+static void bimovegap(BUFFER* buf) {
+    if (buf->gaplen > 0 && buf->cursor < buf->gappos)
+        memmove(buf->data + buf->cursor + buf->gaplen,
+                buf->data + buf->cursor, buf->gappos - buf->cursor);
+    if (buf->gaplen > 0 && buf->cursor > buf->gappos)
+        memmove(buf->data + buf->gappos,
+                buf->data + buf->gappos + buf->gaplen, buf->cursor - buf->gappos);
+    buf->gappos = buf->cursor;
+}
+
 static int biparsemode(const char* mode, BUFFER* buf) {
+    const char* flag;
     if (mode[0] != 'r' && mode[0] != 'w' && mode[0] != 'a') return B_FAIL;
-    if (mode[1] != '+' && mode[1] != '\0') return B_FAIL;
-    if (mode[1] == '+' && mode[2] != '\0') return B_FAIL;
 
     /**/ if (mode[1] == '+') buf->readable = buf->writable = true;
     else if (mode[0] == 'r') buf->readable                 = true;
     else                                     buf->writable = true;
 
+    /* extension flags after access mode */
+    for (flag = mode + 1 + (mode[1] == '+'); *flag; flag++)
+        switch (*flag) {
+            case 'q': if (buf->queue    ) return B_FAIL; buf->queue     = true; break;
+            case 'g': if (buf->gapped   ) return B_FAIL; buf->gapped    = true; break;
+            case 's': if (buf->segmented) return B_FAIL; buf->segmented = true; break;
+            case 'c': if (buf->ring     ) return B_FAIL; buf->ring      = true; break;
+            case 'm': if (buf->concurrent) return B_FAIL; buf->concurrent = true; break;
+            case 'l': if (buf->locked    ) return B_FAIL; buf->locked     = true; break;
+            default: return B_FAIL;
+        }
+
+    /* queue, gap, ring and concurrent modes need own layout of storage */
+    if (buf->queue + buf->gapped + buf->segmented + buf->ring + buf->concurrent > 1) return B_FAIL;
+    /* ring and concurrent modes have own synchronization */
+    if (buf->locked && (buf->ring || buf->concurrent)) return B_FAIL;
+
     return B_OKEY;
 }
 
@@ -76,33 +448,303 @@ int bsetalloc(balloc_t alloc, void* udata) {
         return B_FAIL;
 }
 
-BUFFER* bopen(const void* restrict data, size_t size, const char* restrict mode) {
-    BUFFER* buf = bialloc(NULL, sizeof *buf, biudata);
+/* storage of ring has capacity of power of two and is never resized */
+static int biopenring(BUFFER* buf, const BOPTIONS* opts) {
+    size_t capacity = 1, want = bimax(opts->capacity ? opts->capacity : B_INIT_CAPACITY, opts->size);
+    BUFFER* side; uchar* data;
+    if (!buf->readable || !buf->writable || opts->reserve) return B_FAIL;
+
+    while (capacity < want) {
+        if (capacity > LONG_MAX / 2) return B_FAIL;
+        capacity <<= 1;
+    }
+
+    buf->sides = buf->alloc(NULL, 2 * sizeof *buf->sides, buf->udata);
+    if (!buf->sides) return B_FAIL;
+    memset(buf->sides, 0, 2 * sizeof *buf->sides);
+    data = buf->alloc(NULL, capacity, buf->udata);
+    if (!data) return B_FAIL;
+
+    if (opts->mode[0] != 'w' && opts->size > 0) {
+        memcpy(data, opts->data, opts->size);
+        buf->sides[1].ringtail = (long)opts->size;
+    }
+
+    for (side = buf->sides; side < buf->sides + 2; side++) {
+        side->data     = data;
+        side->capacity = capacity;
+        side->ringmask = capacity - 1;
+        side->fixed    = true;
+        side->alloc    = buf->alloc;
+        side->udata    = buf->udata;
+    }
+    buf->sides[0].readable = true;
+    buf->sides[1].writable = true;
+
+    /* functions without support of ring reject it by storage and access mode */
+    buf->readable = buf->writable = buf->allocated = false;
+    return B_OKEY;
+}
+
+/* view of ring for reader or writer with bytes published by other side,
+ * counters are kept in views of their owners to be apart in memory */
+static BUFFER* biringside(BUFFER* buf, bool writer) {
+    BUFFER* side = &buf->sides[writer];
+    long* head = &buf->sides[0].ringhead;
+    long* tail = &buf->sides[1].ringtail;
+    ulong first, last;
+
+    if (writer) {
+        first = (ulong)biatomicload(head);
+        last  = (ulong)*tail;
+        side->cursor = (size_t)(last - first);
+    } else {
+        first = (ulong)*head;
+        last  = (ulong)biatomicload(tail);
+        side->cursor = 0;
+    }
+
+    side->ringbase = first;
+    side->count = (size_t)(last - first);
+    return side;
+}
+
+/* pass written or read bytes to other side */
+static void biringpublish(BUFFER* side) {
+    if (side->writable)
+        biatomicstore(&side->ringtail, (long)(side->ringbase + side->count));
+    else
+        biatomicstore(&side->ringhead, (long)(side->ringbase + side->cursor));
+}
+
+/* writers of concurrent append buffer use its storage without lock,
+ * readers lock the only view */
+static int biopenconcurrent(BUFFER* buf, const BOPTIONS* opts) {
+    size_t capacity = bimax(opts->capacity ? opts->capacity : B_INIT_CAPACITY, opts->size);
+    BUFFER* side;
+    if (!buf->writable || opts->reserve || capacity > LONG_MAX) return B_FAIL;
+
+    side = buf->sides = buf->alloc(NULL, sizeof *buf->sides, buf->udata);
+    if (!side) return B_FAIL;
+    memset(side, 0, sizeof *side);
+    side->data = buf->alloc(NULL, capacity, buf->udata);
+    if (!side->data) return B_FAIL;
+
+    if (opts->mode[0] != 'w' && opts->size > 0) {
+        memcpy(side->data, opts->data, opts->size);
+        buf->appreserved = buf->apppublished = (long)opts->size;
+    }
+
+    side->capacity  = capacity;
+    side->readable  = buf->readable;
+    side->fixed     = true;
+    side->alloc     = buf->alloc;
+    side->udata     = buf->udata;
+    side->initcap   = buf->initcap;
+    side->growth    = buf->growth;
+    side->threshold = buf->threshold;
+    side->step      = buf->step;
+    side->exact     = buf->exact;
+    buf->appcapacity = (long)capacity;
+    buf->appfailed = LONG_MAX;
+
+    /* functions without support of concurrent mode reject it by storage and access mode */
+    buf->readable = buf->writable = buf->allocated = false;
+    return B_OKEY;
+}
+
+/* storage for reservation up to 'end', writer is counted on success */
+static int bigrowconcurrent(BUFFER* buf, long start, long end) {
+    BUFFER* side = buf->sides;
+    size_t newcap; uchar* newplace;
+    int rc = B_OKEY, spins = 0;
+
+    bilock(&buf->applock);
+    if (end < start || end > biatomicload(&buf->appcapacity)) {
+        /* storage moves only when no writer copies into it */
+        while (biatomicadd(&buf->appwriters, 0)) biatomicwait(spins);
+
+        newcap = binewcap(side, (size_t)biatomicadd(&buf->appreserved, 0));
+        newplace = end < start || newcap > LONG_MAX ? NULL : side->alloc(side->data, newcap, side->udata);
+        if (newplace) {
+            side->data = newplace;
+            side->capacity = newcap;
+            biatomicstore(&buf->appcapacity, (long)newcap);
+        } else
+            rc = B_FAIL;
+    }
+
+    if (rc == B_OKEY)
+        biatomicadd(&buf->appwriters, 1);
+    else if (start < biatomicload(&buf->appfailed))
+        /* later reservations are never published */
+        biatomicstore(&buf->appfailed, start);
+    biunlock(&buf->applock);
+    return rc;
+}
+
+/* append bytes as one record, readers see it complete or do not see it */
+static int biputconcurrent(BUFFER* buf, const void* data, size_t len) {
+    long start, end; int spins = 0;
+    if (len == 0) return B_OKEY;
+    if (len > LONG_MAX) return B_FAIL;
+
+    biatomicadd(&buf->appwriters, 1);
+    start = biatomicadd(&buf->appreserved, (long)len);
+    end = (ulong)start + len > LONG_MAX ? -1L : start + (long)len;
+
+    if (end < start || end > biatomicload(&buf->appcapacity)) {
+        biatomicadd(&buf->appwriters, -1);
+        if (bigrowconcurrent(buf, start, end)) return B_FAIL;
+    }
+    memcpy(buf->sides->data + start, data, len);
+    biatomicadd(&buf->appwriters, -1);
+
+    /* bytes are published after all previous reservations */
+    while (biatomicload(&buf->apppublished) != start) {
+        if (biatomicload(&buf->appfailed) < start) return B_FAIL;
+        biatomicwait(spins);
+    }
+    biatomicstore(&buf->apppublished, end);
+    return B_OKEY;
+}
+
+/* storage of formatting for ring and concurrent append, it is moved to heap on growth */
+typedef struct biscratch_t {
+    uchar*   local;
+    balloc_t alloc;
+    void*    udata;
+} biscratch_t;
+
+static void* biscratchalloc(void* ptr, size_t size, void* udata) {
+    biscratch_t* scratch = udata; uchar* mem;
+    if (ptr != scratch->local) return scratch->alloc(ptr, size, scratch->udata);
+    if (size == 0) return NULL;
+
+    mem = scratch->alloc(NULL, size, scratch->udata);
+    if (mem) memcpy(mem, ptr, bimin(size, B_SCRATCH_CAPACITY));
+    return mem;
+}
+
+/* whole record is formatted before it is put, so readers never see its part */
+static int biprintrecord(BUFFER* buf, const char* fmt, va_list args) {
+    uchar local[B_SCRATCH_CAPACITY];
+    biscratch_t scratch;
+    BUFFER tmp, *side; int ret;
+
+    scratch.local = local;
+    scratch.alloc = buf->alloc;
+    scratch.udata = buf->udata;
+
+    memset(&tmp, 0, sizeof tmp);
+    tmp.data      = local;
+    tmp.capacity  = sizeof local;
+    tmp.writable  = true;
+    tmp.allocated = true;
+    tmp.alloc     = biscratchalloc;
+    tmp.udata     = &scratch;
+
+    ret = vbiprintf(&tmp, fmt, args);
+    if (ret >= 0 && buf->ring) {
+        /* record which does not fit into free part of ring is dropped */
+        side = biringside(buf, true);
+        if (tmp.count > side->capacity - side->count) ret = EOB;
+        else if (tmp.count > 0) {
+            bwrite_unlocked(tmp.data, 1, tmp.count, side);
+            biringpublish(side);
+        }
+    } else if (ret >= 0 && biputconcurrent(buf, tmp.data, tmp.count)) ret = EOB;
+    if (tmp.data != local) buf->alloc(tmp.data, 0, buf->udata);
+    return ret;
+}
+
+/* view for reading of ring or concurrent append buffer */
+static BUFFER* bireadside(BUFFER* buf) {
+    if (buf->ring) return biringside(buf, false);
+
+    bilock(&buf->applock);
+    buf->sides->count = (size_t)biatomicload(&buf->apppublished);
+    return buf->sides;
+}
+
+static void bireaddone(BUFFER* buf, BUFFER* side) {
+    if (buf->ring) biringpublish(side);
+    else biunlock(&buf->applock);
+}
+
+static BUFFER* biopen(const BOPTIONS* opts) {
+    BUFFER* buf = opts->allocator(NULL, sizeof *buf, opts->userdata);
     if (!buf) return NULL;
 
     memset(buf, 0, sizeof *buf);
-    buf->alloc = bialloc;
-    buf->udata = biudata;
+    buf->alloc = opts->allocator;
+    buf->udata = opts->userdata;
+    buf->initcap = opts->capacity;
+    buf->growth = (opts->growth * 128 + 50) / 100;
+    buf->threshold = opts->threshold;
+    buf->step = opts->step;
+    buf->exact = opts->exact != 0;
     buf->allocated = true;
 
-    if (!data && size > 0) goto error;
-    if (!mode || biparsemode(mode, buf)) goto error;
+    if (!opts->data && opts->size > 0) goto error;
+    if (!opts->mode || biparsemode(opts->mode, buf)) goto error;
+    if (buf->ring || buf->concurrent) {
+        if (buf->ring ? biopenring(buf, opts) : biopenconcurrent(buf, opts)) goto error;
+        return buf;
+    }
 
-    if (mode[0] == 'r' || mode[0] == 'a') {
-        if (birequire(buf, size)) goto error;
-        memcpy(buf->data, data, size);
-        buf->count = size;
+    if (opts->reserve) {
+        /* storage of reserved mode is not taken from allocator */
+        if (buf->segmented) goto error;
+        buf->data = bisysreserve(biroundcommit(opts->reserve), opts->hugepages != 0);
+        if (!buf->data) goto error;
+        buf->reserved = biroundcommit(opts->reserve);
+        buf->allocated = false;
     }
 
-    if (mode[0] == 'a')
+    if (opts->mode[0] == 'r' || opts->mode[0] == 'a') {
+        if (birequire(buf, opts->size)) goto error;
+        bistore(buf, 0, opts->data, opts->size);
+        buf->count = opts->size;
+    }
+
+    /* storage with requested capacity is allocated at once */
+    if (opts->capacity && !buf->capacity && birequire(buf, 1)) goto error;
+
+    if (opts->mode[0] == 'a')
         buf->cursor = buf->count;
 
     return buf;
 error:
-    buf->alloc(buf, 0, buf->udata);
+    bclose(buf);
     return NULL;
 }
 
+BUFFER* bopen(const void* restrict data, size_t size, const char* restrict mode) {
+    BOPTIONS opts = {0};
+    opts.data = data;
+    opts.size = size;
+    opts.mode = mode;
+    opts.allocator = bialloc;
+    opts.userdata  = biudata;
+    return biopen(&opts);
+}
+
+BUFFER* bopenex(const BOPTIONS* opts) {
+    BOPTIONS copy;
+    if (!opts) return NULL;
+    if (!opts->allocator && opts->userdata) return NULL;
+    if (opts->growth != 0 && opts->growth <= 100) return NULL;
+    /* factor is kept in 1/128 without overflow */
+    if (opts->growth > UINT_MAX / 128) return NULL;
+    if (opts->reserve > SIZE_MAX - B_COMMIT_STEP) return NULL;
+
+    /* global allocator is not used, so threads do not share state */
+    copy = *opts;
+    if (!copy.allocator) copy.allocator = bidfltalloc;
+    return biopen(&copy);
+}
+
 BUFFER* bmemopen(void* restrict data, size_t size, const char* restrict mode) {
     BUFFER* buf = bialloc(NULL, sizeof *buf, biudata);
     if (!buf) return NULL;
@@ -113,6 +755,7 @@ BUFFER* bmemopen(void* restrict data, size_t size, const char* restrict mode) {
     buf->fixed = true;
 
     if (!mode || biparsemode(mode, buf)) goto error;
+    if (buf->segmented || buf->ring || buf->concurrent) goto error;
 
     buf->capacity = size;
     if (data) {
@@ -133,11 +776,164 @@ error:
     return NULL;
 }
 
+BUFFER* bborrow(const void* data, size_t size) {
+    BUFFER* buf;
+    if (!data && size > 0) return NULL;
+
+    buf = bialloc(NULL, sizeof *buf, biudata);
+    if (!buf) return NULL;
+
+    memset(buf, 0, sizeof *buf);
+    buf->alloc = bialloc;
+    buf->udata = biudata;
+    buf->data = (uchar*)data;
+    buf->count = buf->capacity = size;
+    buf->readable = buf->fixed = buf->borrowed = true;
+
+    return buf;
+}
+
+BUFFER* bmmapopen(const char* restrict path, const char* restrict mode) {
+    BUFFER* buf; size_t size;
+    if (!path || !mode) return NULL;
+
+    buf = bialloc(NULL, sizeof *buf, biudata);
+    if (!buf) return NULL;
+
+    memset(buf, 0, sizeof *buf);
+    buf->alloc = bialloc;
+    buf->udata = biudata;
+    buf->mapped = true;
+
+    if (biparsemode(mode, buf)) goto error;
+    if (buf->queue || buf->gapped || buf->segmented || buf->ring || buf->concurrent || buf->locked) goto error;
+
+    buf->fd = bisysopen(path, mode, &size);
+    if (buf->fd < 0) goto error;
+
+    buf->data = bisysmap(buf->fd, size, buf->writable);
+    if (!buf->data && size > 0) {
+        bisysclose(buf->fd, 0, false);
+        goto error;
+    }
+
+    /* private mapping of read mode is read-only as borrowed data */
+    buf->borrowed = buf->fixed = !buf->writable;
+    buf->count = buf->capacity = size;
+
+    if (mode[0] == 'a')
+        buf->cursor = buf->count;
+
+    return buf;
+error:
+    buf->alloc(buf, 0, buf->udata);
+    return NULL;
+}
+
+BUFFER* battach(void* restrict data, size_t size, size_t capacity, const char* restrict mode) {
+    BUFFER* buf = bialloc(NULL, sizeof *buf, biudata);
+    if (!buf) return NULL;
+
+    memset(buf, 0, sizeof *buf);
+    buf->alloc = bialloc;
+    buf->udata = biudata;
+
+    if (!data != !capacity || size > capacity) goto error;
+    if (!mode || biparsemode(mode, buf)) goto error;
+    if (buf->segmented || buf->ring || buf->concurrent) goto error;
+
+    buf->data = data;
+    buf->capacity = capacity;
+    buf->count = mode[0] == 'w' ? 0 : size;
+    buf->allocated = true;
+
+    if (mode[0] == 'a')
+        buf->cursor = buf->count;
+
+    return buf;
+error:
+    buf->alloc(buf, 0, buf->udata);
+    return NULL;
+}
+
+void* bdetach(BUFFER* restrict buf, size_t* restrict size) {
+    uchar* data;
+    if (!buf || !buf->data || buf->borrowed || buf->mapped || buf->reserved) return NULL;
+    if (buf->inflight) return NULL;
+    /* storage of caller is not passed back as allocated */
+    if (!buf->allocated) return NULL;
+    if (buf->shared && biunshare(buf)) return NULL;
+
+    if (buf->segmented) {
+        /* blocks are joined, it is the only copying case */
+        data = buf->alloc(NULL, bimax(buf->count, 1), buf->udata);
+        if (!data) return NULL;
+        biload(buf, 0, data, buf->count);
+        bifreechunks(buf);
+    } else {
+        biclosegap(buf);
+        bicompact(buf);
+        data = buf->data;
+    }
+
+    if (size) *size = buf->count;
+    buf->alloc(buf, 0, buf->udata);
+    return data;
+}
+
 int bclose(BUFFER* buf) {
+    int rc = B_OKEY;
     if (!buf) return EOB;
-    if (buf->allocated)
-        buf->alloc(buf->data, 0, buf->udata);
+    /* storage is freed only after completion */
+    if (buf->inflight) return EOB;
+    if (buf->sink)
+        rc = biflush(buf, buf->count);
+    if (buf->mapped) {
+        bisysunmap(buf->data, buf->capacity);
+        /* file loses unused tail of mapping */
+        rc = bisysclose(buf->fd, buf->count, buf->writable) || rc;
+    } else if (buf->reserved)
+        bisysunmap(bistorage(buf), buf->reserved);
+    else if (buf->shared)
+        birelease(buf->shared);
+    else if (buf->ring || buf->concurrent) {
+        if (buf->sides && buf->sides[0].data)
+            buf->alloc(buf->sides[0].data, 0, buf->udata);
+        buf->alloc(buf->sides, 0, buf->udata);
+    } else if (buf->segmented)
+        bifreechunks(buf);
+    else if (buf->allocated)
+        buf->alloc(bistorage(buf), 0, buf->udata);
     buf->alloc(buf, 0, buf->udata);
+    return rc ? EOB : B_OKEY;
+}
+
+int bsync(BUFFER* buf) {
+    if (!buf) return EOB;
+    if (buf->sink) return biflush(buf, buf->count) ? EOB : B_OKEY;
+    if (!buf->mapped || !buf->writable) return B_OKEY;
+    return bisyssync(buf->data, buf->count) ? EOB : B_OKEY;
+}
+
+int bsetsink(BUFFER* buf, bsink_t sink, void* udata, size_t limit) {
+    if (!buf || !buf->writable || buf->source) return B_FAIL;
+    if (buf->segmented || buf->gapped || buf->mapped || buf->shared) return B_FAIL;
+    if (!sink && udata) return B_FAIL;
+
+    buf->sink = sink;
+    buf->sinkdata = udata;
+    buf->sinklimit = limit ? limit : B_INIT_CAPACITY;
+    return B_OKEY;
+}
+
+int bsetsource(BUFFER* buf, bsource_t source, void* udata) {
+    if (!buf || !buf->readable || buf->sink) return B_FAIL;
+    if (buf->segmented || buf->gapped || buf->mapped || buf->borrowed || buf->shared) return B_FAIL;
+    if (!source && udata) return B_FAIL;
+    if (source && !buf->data && birequire(buf, 1)) return B_FAIL;
+
+    buf->source = source;
+    buf->sourcedata = udata;
     return B_OKEY;
 }
 
@@ -149,6 +945,7 @@ int bgetpos(BUFFER* restrict buf, bpos_t* restrict pos) {
 
 int bsetpos(BUFFER* buf, const bpos_t* pos) {
     if (!buf || !buf->data || !pos) return B_FAIL;
+    if (buf->ring || buf->concurrent) return B_FAIL;
     if (*pos > buf->count) return B_FAIL;
     buf->cursor = *pos;
     return B_OKEY;
@@ -156,12 +953,14 @@ int bsetpos(BUFFER* buf, const bpos_t* pos) {
 
 long btell(BUFFER* buf) {
     if (!buf || !buf->data) return -1L;
+    if (buf->ring || buf->concurrent) return -1L;
     if (buf->cursor > LONG_MAX) return -1L;
     return buf->cursor;
 }
 
 int bseek(BUFFER* buf, long off, int org) {
     if (!buf || !buf->data) return B_FAIL;
+    if (buf->ring || buf->concurrent) return B_FAIL;
 
     switch (org) {
         case BSEEK_SET:
@@ -185,36 +984,74 @@ int bseek(BUFFER* buf, long off, int org) {
 }
 
 void brewind(BUFFER* buf) {
-    if (!buf) return;
+    if (!buf || buf->ring || buf->concurrent) return;
     buf->cursor = 0;
 }
 
 int bgetc(BUFFER* buf) {
+    int ret;
+    if (!buf || !buf->locked) return bgetc_unlocked(buf);
+    bilock(&buf->lock);
+    ret = bgetc_unlocked(buf);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+int bgetc_unlocked(BUFFER* buf) {
+    if (buf && buf->sides) {
+        BUFFER* side = bireadside(buf);
+        int ch = bgetc_unlocked(side);
+        bireaddone(buf, side);
+        return ch;
+    }
     if (!buf || !buf->data || !buf->readable) return EOB;
-    if (buf->cursor == buf->count) return EOB;
-    return buf->data[buf->cursor++];
+    biclosegap(buf);
+    if (buf->cursor == buf->count && birefill(buf, 1)) return EOB;
+    return *biat(buf, buf->cursor++);
 }
 
 char* bgets(char* restrict str, int count, BUFFER* restrict buf) {
-    uchar* newline; size_t minlen, offset;
+    char* ret;
+    if (!buf || !buf->locked) return bgets_unlocked(str, count, buf);
+    bilock(&buf->lock);
+    ret = bgets_unlocked(str, count, buf);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+char* bgets_unlocked(char* restrict str, int count, BUFFER* restrict buf) {
+    uchar* newline; size_t minlen, limit, len;
+    if (buf && buf->sides) {
+        BUFFER* side = bireadside(buf);
+        char* ret = bgets_unlocked(str, count, side);
+        bireaddone(buf, side);
+        return ret;
+    }
     if (!buf || !buf->data || !str) return NULL;
     if (!buf->readable) return NULL;
+    biclosegap(buf);
 
-    if (buf->count == buf->cursor) return NULL;
+    if (buf->count == buf->cursor && birefill(buf, 1)) return NULL;
     if (count < 1) return NULL;
     if (count == 1) {
         str[0] = '\0';
         return str;
     }
 
-    newline = memchr(buf->data + buf->cursor, '\n', buf->count - buf->cursor);
-    if (newline) {
-        offset = newline - buf->data - buf->cursor;
-        minlen = bimin(offset + 1, count - 1);
-    } else
-        minlen = bimin(buf->count - buf->cursor, count - 1);
+    limit = count - 1;
+    for (minlen = 0; minlen < limit; minlen += len) {
+        uchar* span;
+        if (minlen == buf->count - buf->cursor && birefill(buf, minlen + 1)) break;
+        span = bispan(buf, buf->cursor + minlen, &len);
+        len = bimin(len, bimin(buf->count - buf->cursor, limit) - minlen);
+        newline = memchr(span, '\n', len);
+        if (newline) {
+            minlen += (newline - span) + 1;
+            break;
+        }
+    }
 
-    memcpy(str, buf->data + buf->cursor, minlen);
+    biload(buf, buf->cursor, str, minlen);
     buf->cursor += minlen;
     str[minlen] = '\0';
 
@@ -222,23 +1059,61 @@ char* bgets(char* restrict str, int count, BUFFER* restrict buf) {
 }
 
 int bputc(int ch, BUFFER* buf) {
+    int ret;
+    if (!buf || !buf->locked) return bputc_unlocked(ch, buf);
+    bilock(&buf->lock);
+    ret = bputc_unlocked(ch, buf);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+int bputc_unlocked(int ch, BUFFER* buf) {
+    if (buf && buf->ring) {
+        BUFFER* side = biringside(buf, true);
+        int ret = bputc_unlocked(ch, side);
+        biringpublish(side);
+        return ret;
+    }
+    if (buf && buf->concurrent) {
+        uchar byte = (uchar)ch;
+        return biputconcurrent(buf, &byte, 1) ? EOB : byte;
+    }
     if (!buf || !buf->writable) return EOB;
+    biclosegap(buf);
     if (birequire(buf, 1)) return EOB;
 
-    buf->data[buf->cursor++] = (uchar)ch;
+    *biat(buf, buf->cursor++) = (uchar)ch;
     buf->count = bimax(buf->count, buf->cursor);
 
     return ch;
 }
 
 int bputs(const char* restrict str, BUFFER* restrict buf) {
+    int ret;
+    if (!buf || !buf->locked) return bputs_unlocked(str, buf);
+    bilock(&buf->lock);
+    ret = bputs_unlocked(str, buf);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+int bputs_unlocked(const char* restrict str, BUFFER* restrict buf) {
     size_t len;
+    if (buf && buf->ring) {
+        BUFFER* side = biringside(buf, true);
+        int ret = bputs_unlocked(str, side);
+        biringpublish(side);
+        return ret;
+    }
+    if (buf && buf->concurrent)
+        return str && !biputconcurrent(buf, str, strlen(str)) ? B_OKEY : EOB;
     if (!buf || !str || !buf->writable) return EOB;
+    biclosegap(buf);
 
     len = strlen(str);
     if (birequire(buf, len)) return EOB;
 
-    memcpy(buf->data + buf->cursor, str, len);
+    bistore(buf, buf->cursor, str, len);
     buf->count = bimax(buf->count, buf->cursor += len);
 
     return B_OKEY;
@@ -246,102 +1121,533 @@ int bputs(const char* restrict str, BUFFER* restrict buf) {
 
 int bungetc(int ch, BUFFER* buf) {
     if (!buf || !buf->data) return EOB;
+    if (buf->ring || buf->concurrent) return EOB;
     if (!buf->readable) return EOB;
     if (ch == EOB) return EOB;
+    if (buf->inflight) return EOB;
+    biclosegap(buf);
 
     if (buf->cursor == 0) return EOB;
-    buf->data[--buf->cursor] = (uchar)ch;
+    /* shared storage is copied only for another byte */
+    if (buf->shared && *biat(buf, buf->cursor - 1) != (uchar)ch && biunshare(buf)) return EOB;
+    if (buf->borrowed || buf->shared) {
+        /* storage can not be changed, only the same byte is returned */
+        if (*biat(buf, buf->cursor - 1) != (uchar)ch) return EOB;
+        --buf->cursor;
+        return ch;
+    }
+    *biat(buf, --buf->cursor) = (uchar)ch;
 
     return ch;
 }
 
 int bscanf(BUFFER* restrict buf, const char* restrict fmt, ...) {
     int ret; va_list args;
-    if (!buf || !fmt || !buf->readable) return EOB;
     va_start(args, fmt);
-    ret = vbiscanf(buf, fmt, args);
+    ret = vbscanf(buf, fmt, args);
+    va_end(args);
+    return ret;
+}
+
+int bscanf_unlocked(BUFFER* restrict buf, const char* restrict fmt, ...) {
+    int ret; va_list args;
+    va_start(args, fmt);
+    ret = vbscanf_unlocked(buf, fmt, args);
     va_end(args);
     return ret;
 }
 
 int vbscanf(BUFFER* restrict buf, const char* restrict fmt, va_list args) {
+    int ret;
+    if (!buf || !buf->locked) return vbscanf_unlocked(buf, fmt, args);
+    bilock(&buf->lock);
+    ret = vbscanf_unlocked(buf, fmt, args);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+int vbscanf_unlocked(BUFFER* restrict buf, const char* restrict fmt, va_list args) {
+    if (buf && buf->sides) {
+        BUFFER* side = bireadside(buf);
+        int ret = vbscanf_unlocked(side, fmt, args);
+        bireaddone(buf, side);
+        return ret;
+    }
     if (!buf || !fmt || !buf->readable) return EOB;
+    biclosegap(buf);
     return vbiscanf(buf, fmt, args);
 }
 
 int bprintf(BUFFER* restrict buf, const char* restrict fmt, ...) {
     int ret; va_list args;
-    if (!buf || !fmt || !buf->writable) return EOB;
     va_start(args, fmt);
-    ret = vbiprintf(buf, fmt, args);
+    ret = vbprintf(buf, fmt, args);
+    va_end(args);
+    return ret;
+}
+
+int bprintf_unlocked(BUFFER* restrict buf, const char* restrict fmt, ...) {
+    int ret; va_list args;
+    va_start(args, fmt);
+    ret = vbprintf_unlocked(buf, fmt, args);
     va_end(args);
     return ret;
 }
 
 int vbprintf(BUFFER* restrict buf, const char* restrict fmt, va_list args) {
+    int ret;
+    if (!buf || !buf->locked) return vbprintf_unlocked(buf, fmt, args);
+    bilock(&buf->lock);
+    ret = vbprintf_unlocked(buf, fmt, args);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+int vbprintf_unlocked(BUFFER* restrict buf, const char* restrict fmt, va_list args) {
+    if (buf && (buf->ring || buf->concurrent))
+        return fmt ? biprintrecord(buf, fmt, args) : EOB;
     if (!buf || !fmt || !buf->writable) return EOB;
+    biclosegap(buf);
     return vbiprintf(buf, fmt, args);
 }
 
 size_t bread(void* restrict data, size_t size, size_t count, BUFFER* restrict buf) {
+    size_t ret;
+    if (!buf || !buf->locked) return bread_unlocked(data, size, count, buf);
+    bilock(&buf->lock);
+    ret = bread_unlocked(data, size, count, buf);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+size_t bread_unlocked(void* restrict data, size_t size, size_t count, BUFFER* restrict buf) {
+    if (buf && buf->sides) {
+        BUFFER* side = bireadside(buf);
+        size_t ret = bread_unlocked(data, size, count, side);
+        bireaddone(buf, side);
+        return ret;
+    }
     if (!buf || !buf->data || !buf->readable) return 0;
     if (!data || !size || !count) return 0;
+    biclosegap(buf);
 
+    if (buf->count - buf->cursor < size * count) birefill(buf, size * count);
     count = bimin((buf->count - buf->cursor) / size, count);
-    memcpy(data, buf->data + buf->cursor, size * count);
+    biload(buf, buf->cursor, data, size * count);
     buf->cursor += size * count;
 
     return count;
 }
 
 size_t bwrite(const void* restrict data, size_t size, size_t count, BUFFER* restrict buf) {
+    size_t ret;
+    if (!buf || !buf->locked) return bwrite_unlocked(data, size, count, buf);
+    bilock(&buf->lock);
+    ret = bwrite_unlocked(data, size, count, buf);
+    biunlock(&buf->lock);
+    return ret;
+}
+
+size_t bwrite_unlocked(const void* restrict data, size_t size, size_t count, BUFFER* restrict buf) {
+    if (buf && buf->ring) {
+        BUFFER* side = biringside(buf, true);
+        size_t ret = bwrite_unlocked(data, size, count, side);
+        biringpublish(side);
+        return ret;
+    }
+    if (buf && buf->concurrent) {
+        if (!data || !size || !count || count > SIZE_MAX / size) return 0;
+        return biputconcurrent(buf, data, size * count) ? 0 : count;
+    }
     if (!buf || !buf->writable) return 0;
     if (!data || !size || !count) return 0;
+    biclosegap(buf);
 
     if (birequire(buf, size * count))
-        count = (buf->capacity - buf->cursor) / size;
+        count = bipinned(buf) ? 0 : (buf->capacity - buf->cursor) / size;
 
-    memcpy(buf->data + buf->cursor, data, size * count);
+    bistore(buf, buf->cursor, data, size * count);
     buf->count = bimax(buf->count, buf->cursor += size * count);
 
     return count;
 }
 
 int beob(BUFFER* buf) {
+    if (buf && buf->sides) {
+        BUFFER* side = bireadside(buf);
+        int ret = side->cursor == side->count;
+        bireaddone(buf, side);
+        return ret;
+    }
     if (!buf || !buf->data) return 0;
-    return buf->cursor == buf->count;
+    return buf->cursor == buf->count && birefill(buf, 1);
 }
 
 /* API extension */
 
 int bpeek(BUFFER* buf) {
+    if (buf && buf->sides) {
+        BUFFER* side = bireadside(buf);
+        int ch = bpeek(side);
+        bireaddone(buf, side);
+        return ch;
+    }
     if (!buf || !buf->data || !buf->readable) return EOB;
-    if (buf->cursor == buf->count) return EOB;
-    return buf->data[buf->cursor];
+    biclosegap(buf);
+    if (buf->cursor == buf->count && birefill(buf, 1)) return EOB;
+    return *biat(buf, buf->cursor);
 }
 
 int berase(BUFFER* buf, size_t count) {
     if (!buf || !buf->data || !buf->writable) return B_FAIL;
+    if (buf->inflight) return B_FAIL;
+    if (buf->shared && biunshare(buf)) return B_FAIL;
     count = bimin(count, buf->count - buf->cursor);
-    memmove(buf->data  + buf->cursor,
-            buf->data  + buf->cursor + count,
-            buf->count - buf->cursor - count);
+    bimarkdirty(buf);
+
+    if (buf->gapped) {
+        /* erased bytes are joined to the gap */
+        bimovegap(buf);
+        buf->gaplen += count;
+        buf->count  -= count;
+        return B_OKEY;
+    }
+
+    if (buf->queue && buf->cursor <= buf->count - buf->cursor - count) {
+        /* in queue mode move the shorter prefix forward instead of tail */
+        memmove(buf->data + count, buf->data, buf->cursor);
+        buf->data     += count;
+        buf->shift    += count;
+        buf->capacity -= count;
+        buf->count    -= count;
+        return B_OKEY;
+    }
+
+    bimovewithin(buf, buf->cursor, buf->cursor + count,
+        buf->count - buf->cursor - count);
     buf->count -= count;
     return B_OKEY;
 }
 
+int binsert(const void* restrict data, size_t size, BUFFER* restrict buf) {
+    size_t tail;
+    if (!buf || !buf->writable) return B_FAIL;
+    if (!data || !size) return B_FAIL;
+    if (buf->inflight) return B_FAIL;
+    if (buf->shared && biunshare(buf)) return B_FAIL;
+
+    if (!buf->gapped) {
+        tail = buf->count - buf->cursor;
+        if (birequire(buf, tail + size)) return B_FAIL;
+        bimovewithin(buf, buf->cursor + size, buf->cursor, tail);
+    } else {
+        bimovegap(buf);
+        if (buf->gaplen < size) {
+            /* grow storage and move the part after gap to its end */
+            tail = buf->count - buf->cursor;
+            if (birequire(buf, tail + size)) return B_FAIL;
+            memmove(buf->data + buf->capacity - tail,
+                    buf->data + buf->gappos + buf->gaplen, tail);
+            buf->gaplen = buf->capacity - buf->count;
+        }
+    }
+
+    bistore(buf, buf->cursor, data, size);
+    if (buf->gapped) {
+        buf->gappos += size;
+        buf->gaplen -= size;
+    }
+    buf->cursor += size;
+    buf->count  += size;
+    return B_OKEY;
+}
+
 int breset(BUFFER* buf) {
+    return bresetex(buf, 0);
+}
+
+int bresetex(BUFFER* buf, int flags) {
     if (!buf || !buf->data || !buf->writable) return B_FAIL;
-    memset(buf->data, 0, buf->capacity);
+    if (flags & ~(BRESET_WIPE | BRESET_RELEASE)) return B_FAIL;
+    if (buf->inflight) return B_FAIL;
+    /* failed copying leaves buffer unchanged */
+    if (buf->shared && biunshare(buf)) return B_FAIL;
+    bimarkdirty(buf);
+    buf->data      = bistorage(buf);
+    buf->capacity += buf->shift;
+    buf->shift = buf->gaplen = 0;
     buf->cursor = buf->count = 0;
+
+    /* erased and dropped bytes are before the end of used part */
+    if (flags & BRESET_WIPE) biwipe(buf);
+    /* storage which can not be released is kept */
+    if (flags & BRESET_RELEASE) bshrink(buf);
+    return B_OKEY;
+}
+
+int bshrink(BUFFER* buf) {
+    size_t keep; uchar* newplace;
+    if (!buf || buf->inflight) return B_FAIL;
+
+    if (buf->reserved) {
+        /* pages after the content are released, range is kept */
+        biclosegap(buf);
+        bicompact(buf);
+        keep = biroundcommit(buf->count);
+        bisysdecommit(buf->data + keep, buf->capacity - bimin(keep, buf->capacity));
+        buf->capacity = bimin(keep, buf->capacity);
+        return B_OKEY;
+    }
+
+    if (!buf->allocated || buf->fixed || buf->mapped) return B_FAIL;
+
+    if (buf->segmented) {
+        /* blocks after the content are freed */
+        keep = (buf->count + B_CHUNK_CAPACITY - 1) / B_CHUNK_CAPACITY;
+        while (buf->nchunks > keep)
+            buf->alloc(buf->chunks[--buf->nchunks], 0, buf->udata);
+        buf->capacity = buf->nchunks * B_CHUNK_CAPACITY;
+        if (buf->nchunks == 0) buf->data = NULL;
+        return B_OKEY;
+    }
+
+    if (!buf->data) return B_OKEY;
+    biclosegap(buf);
+    bicompact(buf);
+    if (buf->count == buf->capacity) return B_OKEY;
+
+    if (buf->count == 0) {
+        buf->alloc(buf->data, 0, buf->udata);
+        buf->data = NULL;
+        buf->capacity = 0;
+        return B_OKEY;
+    }
+
+    newplace = buf->alloc(buf->data, buf->count, buf->udata);
+    if (!newplace) return B_FAIL;
+    buf->data = newplace;
+    buf->capacity = buf->count;
+    return B_OKEY;
+}
+
+/* Sharing extension */
+
+int bfreeze(BUFFER* buf) {
+    bishared_t* shared;
+    if (!buf || buf->inflight) return B_FAIL;
+    if (buf->shared) return B_OKEY;
+    if (!buf->allocated || buf->fixed || buf->segmented || buf->mapped || buf->reserved) return B_FAIL;
+    if (buf->sink || buf->source) return B_FAIL;
+
+    shared = buf->alloc(NULL, sizeof *shared, buf->udata);
+    if (!shared) return B_FAIL;
+
+    /* clones read content from storage, so it must be contiguous */
+    biclosegap(buf);
+    shared->refs    = 1;
+    shared->storage = bistorage(buf);
+    shared->alloc   = buf->alloc;
+    shared->udata   = buf->udata;
+
+    buf->shared = shared;
+    buf->allocated = false;
     return B_OKEY;
 }
 
+BUFFER* bclone(BUFFER* buf) {
+    BUFFER* copy;
+    if (!buf || bfreeze(buf)) return NULL;
+
+    copy = buf->alloc(NULL, sizeof *copy, buf->udata);
+    if (!copy) return NULL;
+
+    *copy = *buf;
+    copy->cursor = copy->gappos = 0;
+    copy->lock = B_LOCK_INIT;
+    biatomicadd(&buf->shared->refs, 1);
+    return copy;
+}
+
+/* Locking extension */
+
+void block(BUFFER* buf) {
+    if (buf) bilock(&buf->lock);
+}
+
+void bunlock(BUFFER* buf) {
+    if (buf) biunlock(&buf->lock);
+}
+
+/* Direct access extension */
+
+void* bwritebegin(BUFFER* restrict buf, size_t minsize, size_t* restrict avail) {
+    uchar* ptr; size_t len;
+    if (!buf || !buf->writable) return NULL;
+    if (buf->segmented && minsize > B_CHUNK_CAPACITY) return NULL;
+    biclosegap(buf);
+    if (birequire(buf, minsize) || !buf->data) return NULL;
+
+    buf->spared = false;
+    ptr = bispan(buf, buf->cursor, &len);
+    if (len < minsize) {
+        if (!buf->segmented) return NULL;
+        /* rest of block is too short, bytes are written to spare block
+         * and copied over the end of block by commit */
+        if (!buf->spare) buf->spare = buf->alloc(NULL, B_CHUNK_CAPACITY, buf->udata);
+        if (!buf->spare) return NULL;
+        buf->spared = true;
+        ptr = buf->spare;
+        len = B_CHUNK_CAPACITY;
+    } else
+        /* caller may write whole span without commit */
+        buf->dirty = bimax(buf->dirty, buf->shift + buf->cursor + len);
+    if (avail) *avail = len;
+    return ptr;
+}
+
+int bwritecommit(BUFFER* buf, size_t count) {
+    size_t len;
+    if (!buf || !buf->data || !buf->writable) return B_FAIL;
+    if (buf->inflight) return B_FAIL;
+
+    if (buf->spared) {
+        if (count > B_CHUNK_CAPACITY || birequire(buf, count)) return B_FAIL;
+        buf->spared = false;
+        bistore(buf, buf->cursor, buf->spare, count);
+    } else {
+        bispan(buf, buf->cursor, &len);
+        if (count > len) return B_FAIL;
+    }
+    buf->count = bimax(buf->count, buf->cursor += count);
+    return B_OKEY;
+}
+
+const void* bpeekspan(BUFFER* restrict buf, size_t* restrict len) {
+    uchar* ptr; size_t avail;
+    if (!buf || !buf->data || !buf->readable) return NULL;
+    biclosegap(buf);
+    if (buf->cursor == buf->count) birefill(buf, 1);
+
+    ptr = bispan(buf, buf->cursor, &avail);
+    if (len) *len = bimin(avail, buf->count - buf->cursor);
+    return ptr;
+}
+
+int bconsume(BUFFER* buf, size_t count) {
+    if (!buf || !buf->data || !buf->readable) return B_FAIL;
+    if (count > buf->count - buf->cursor && birefill(buf, count)) return B_FAIL;
+    buf->cursor += count;
+    return B_OKEY;
+}
+
+size_t breadv(BUFFER* restrict buf, const BUFVEC* restrict vec, size_t count) {
+    size_t i, part, done, total = 0;
+    if (!buf || !buf->data || !buf->readable || !vec) return 0;
+    biclosegap(buf);
+
+    for (i = 0; i < count; i++) total += vec[i].size;
+    if (buf->count - buf->cursor < total) birefill(buf, total);
+    total = bimin(total, buf->count - buf->cursor);
+
+    for (i = done = 0; done < total; i++, done += part) {
+        part = bimin(vec[i].size, total - done);
+        if (part) biload(buf, buf->cursor + done, vec[i].base, part);
+    }
+    buf->cursor += total;
+
+    return total;
+}
+
+size_t bwritev(BUFFER* restrict buf, const BUFVEC* restrict vec, size_t count) {
+    size_t i, part, done, total = 0;
+    if (!buf || !buf->writable || !vec) return 0;
+    biclosegap(buf);
+
+    /* whole message is reserved once */
+    for (i = 0; i < count; i++) total += vec[i].size;
+    if (birequire(buf, total))
+        total = bipinned(buf) ? 0 : buf->capacity - buf->cursor;
+
+    for (i = done = 0; done < total; i++, done += part) {
+        part = bimin(vec[i].size, total - done);
+        if (part) bistore(buf, buf->cursor + done, vec[i].base, part);
+    }
+    buf->count = bimax(buf->count, buf->cursor += total);
+
+    return total;
+}
+
+/* reserve up to 'max' bytes after content, returns count of reserved */
+static size_t bireserve(BUFFER* buf, size_t max) {
+    if (birequire(buf, buf->count - buf->cursor + max))
+        max = bipinned(buf) ? 0 : buf->capacity - buf->count;
+    return max;
+}
+
+/* advance position over written bytes, in queue mode they are dropped */
+static void biadvance(BUFFER* buf, size_t len) {
+    buf->cursor += len;
+    if (buf->queue && buf->writable) {
+        buf->data     += buf->cursor;
+        buf->shift    += buf->cursor;
+        buf->capacity -= buf->cursor;
+        buf->count    -= buf->cursor;
+        buf->cursor    = 0;
+    }
+}
+
+/* parts of storage from 'pos' with 'len' bytes, at most B_SYS_VEC_COUNT */
+static int bivec(BUFFER* buf, size_t pos, size_t len, BUFVEC* vec) {
+    int count; size_t step;
+    for (count = 0; len > 0 && count < B_SYS_VEC_COUNT; count++) {
+        vec[count].base = bispan(buf, pos, &step);
+        vec[count].size = step = bimin(step, len);
+        pos += step, len -= step;
+    }
+    return count;
+}
+
+long bfillfd(BUFFER* buf, int fd, size_t max) {
+    BUFVEC vec[B_SYS_VEC_COUNT]; long got;
+    if (!buf || !buf->writable || max == 0) return EOB;
+    biclosegap(buf);
+
+    /* bytes are appended after content, position stays for reading */
+    max = bireserve(buf, bimin(max, LONG_MAX));
+    if (max == 0) return EOB;
+
+    got = bisysreadv(fd, vec, bivec(buf, buf->count, max, vec));
+    if (got < 0) return EOB;
+    buf->count += got;
+    return got;
+}
+
+long bdrainfd(BUFFER* buf, int fd) {
+    BUFVEC vec[B_SYS_VEC_COUNT]; long got, total = 0; int count; size_t i, size;
+    if (!buf || !buf->data || !buf->readable) return EOB;
+    biclosegap(buf);
+
+    while (buf->cursor < buf->count) {
+        count = bivec(buf, buf->cursor, bimin(buf->count - buf->cursor, LONG_MAX - total), vec);
+        for (size = i = 0; i < (size_t)count; i++) size += vec[i].size;
+
+        got = bisyswritev(fd, vec, count);
+        if (got < 0 && total == 0) return EOB;
+        if (got <= 0) break;
+        biadvance(buf, got);
+        total += got;
+        if ((size_t)got < size || total == LONG_MAX) break;
+    }
+
+    return total;
+}
+
 /* View extension */
 
 BUFVIEW bview(BUFFER* buf) {
     BUFVIEW view = {0};
-    if (buf && buf->data) {
+    if (buf && buf->data && (!buf->segmented || buf->nchunks == 1)) {
+        biclosegap(buf);
         view.base = buf->data;
         view.head = buf->data + buf->cursor;
         view.stop = buf->data + buf->count;
@@ -349,13 +1655,188 @@ BUFVIEW bview(BUFFER* buf) {
     return view;
 }
 
+size_t bviewv(BUFFER* restrict buf, BUFSPAN* restrict spans, size_t count) {
+    size_t pos, len, total = 0;
+    if (!buf || !buf->data) return 0;
+    biclosegap(buf);
+
+    for (pos = 0; pos < buf->count; pos += len, total++) {
+        const uchar* ptr = bispan(buf, pos, &len);
+        len = bimin(len, buf->count - pos);
+        if (total < count) {
+            spans[total].base = ptr;
+            spans[total].size = len;
+        }
+    }
+
+    return total;
+}
+
+/* Reader extension, readers never change the buffer */
+
+BREADER breader(BUFFER* buf) {
+    BREADER reader = {0};
+    if (buf && buf->readable) {
+        biclosegap(buf);
+        reader.buffer = buf;
+    }
+    return reader;
+}
+
+int brgetc(BREADER* reader) {
+    BUFFER* buf;
+    if (!reader || !(buf = reader->buffer)) return EOB;
+    if (reader->pos >= buf->count) return EOB;
+    return *biat(buf, reader->pos++);
+}
+
+char* brgets(char* restrict str, int count, BREADER* restrict reader) {
+    BUFFER* buf; uchar *span, *newline; size_t minlen, limit, len;
+    if (!reader || !(buf = reader->buffer) || !str) return NULL;
+    if (reader->pos >= buf->count || count < 1) return NULL;
+
+    limit = bimin(buf->count - reader->pos, (size_t)count - 1);
+    for (minlen = 0; minlen < limit; minlen += len) {
+        span = bispan(buf, reader->pos + minlen, &len);
+        len = bimin(len, limit - minlen);
+        newline = memchr(span, '\n', len);
+        if (newline) {
+            minlen += (newline - span) + 1;
+            break;
+        }
+    }
+
+    biload(buf, reader->pos, str, minlen);
+    reader->pos += minlen;
+    str[minlen] = '\0';
+    return str;
+}
+
+size_t brread(void* restrict data, size_t size, size_t count, BREADER* restrict reader) {
+    BUFFER* buf;
+    if (!reader || !(buf = reader->buffer)) return 0;
+    if (!data || !size || !count || reader->pos >= buf->count) return 0;
+
+    count = bimin((buf->count - reader->pos) / size, count);
+    biload(buf, reader->pos, data, size * count);
+    reader->pos += size * count;
+    return count;
+}
+
+int brscanf(BREADER* restrict reader, const char* restrict fmt, ...) {
+    int ret; va_list args;
+    va_start(args, fmt);
+    ret = vbrscanf(reader, fmt, args);
+    va_end(args);
+    return ret;
+}
+
+int vbrscanf(BREADER* restrict reader, const char* restrict fmt, va_list args) {
+    BUFFER view; int ret;
+    if (!reader || !reader->buffer || !fmt) return EOB;
+
+    /* scanning moves position of private copy, source is not read */
+    view = *reader->buffer;
+    view.cursor = bimin(reader->pos, view.count);
+    view.source = NULL;
+    ret = vbiscanf(&view, fmt, args);
+    reader->pos = view.cursor;
+    return ret;
+}
+
+/* Implementation of storage functions for asynchronous io */
+
+void* bispare(BUFFER* buf, size_t max, size_t* len) {
+    uchar* ptr;
+    if (!buf->writable || max == 0) return NULL;
+    biclosegap(buf);
+
+    max = bireserve(buf, max);
+    if (max == 0) return NULL;
+    ptr = bispan(buf, buf->count, len);
+    *len = bimin(*len, max);
+    return ptr;
+}
+
+void biappend(BUFFER* buf, size_t len) {
+    buf->count += len;
+}
+
+void biconsume(BUFFER* buf, size_t len) {
+    biadvance(buf, len);
+}
+
+bool biinflight(const BUFFER* buf) {
+    return buf->inflight;
+}
+
+void bimarkio(BUFFER* buf, bool inflight) {
+    buf->inflight = inflight;
+}
+
+void bicurrentalloc(balloc_t* alloc, void** udata) {
+    *alloc = bialloc;
+    *udata = biudata;
+}
+
+void* bifixedstorage(BUFFER* buf, size_t* size) {
+    if (!buf->fixed || buf->segmented || buf->borrowed || !buf->data) return NULL;
+    *size = buf->shift + buf->capacity;
+    return bistorage(buf);
+}
+
+/* Implementation of storage functions for pool */
+
+size_t bicapacity(BUFFER* buf) {
+    return buf->shift + buf->capacity;
+}
+
+static int biparsereuse(const char* mode, BUFFER* buf) {
+    if (!mode || mode[0] != 'w' || biparsemode(mode, buf)) return B_FAIL;
+    if (buf->segmented || buf->ring || buf->concurrent) return B_FAIL;
+    return B_OKEY;
+}
+
+int bireusemode(const char* mode) {
+    BUFFER fresh;
+    memset(&fresh, 0, sizeof fresh);
+    return biparsereuse(mode, &fresh);
+}
+
+int bireuse(BUFFER* buf, const char* mode) {
+    BUFFER fresh;
+    memset(&fresh, 0, sizeof fresh);
+    if (biparsereuse(mode, &fresh)) return B_FAIL;
+    /* storage used by kernel is not given to another owner */
+    if (buf->inflight) return B_FAIL;
+
+    /* only own contiguous storage is kept, content is dropped */
+    if (!buf->allocated || buf->fixed || buf->segmented || buf->mapped) return B_FAIL;
+    if (buf->sink) biflush(buf, buf->count);
+    bimarkdirty(buf);
+
+    fresh.data      = bistorage(buf);
+    fresh.dirty     = buf->dirty;
+    fresh.capacity  = buf->shift + buf->capacity;
+    fresh.alloc     = buf->alloc;
+    fresh.udata     = buf->udata;
+    fresh.initcap   = buf->initcap;
+    fresh.growth    = buf->growth;
+    fresh.threshold = buf->threshold;
+    fresh.step      = buf->step;
+    fresh.exact     = buf->exact;
+    fresh.allocated = true;
+    *buf = fresh;
+    return B_OKEY;
+}
+
 /* Implementation of immediately functions,
  * need access to the fields of BUFFER and few static functions
  */
 
 int biimmputc(int ch, BUFFER* buf, int* accumulator) {
     if (birequire(buf, 1)) return B_FAIL;
-    buf->data[buf->cursor++] = (uchar)ch;
+    *biat(buf, buf->cursor++) = (uchar)ch;
     buf->count = bimax(buf->count, buf->cursor);
     *accumulator += 1;
     return B_OKEY;
@@ -364,8 +1845,8 @@ int biimmputc(int ch, BUFFER* buf, int* accumulator) {
 int biimmputs(const char* str, size_t len, BUFFER* buf, int* accumulator) {
     int rc = B_OKEY;
     if (birequire(buf, len))
-        len = buf->capacity - buf->cursor, rc = B_FAIL;
-    memcpy(buf->data + buf->cursor, str, len);
+        len = bipinned(buf) ? 0 : buf->capacity - buf->cursor, rc = B_FAIL;
+    bistore(buf, buf->cursor, str, len);
     buf->count = bimax(buf->count, buf->cursor += len);
     *accumulator += len;
     return rc;
@@ -374,17 +1855,18 @@ int biimmputs(const char* str, size_t len, BUFFER* buf, int* accumulator) {
 int biimmrepc(int ch, size_t count, BUFFER* buf, int* accumulator) {
     int rc = B_OKEY;
     if (birequire(buf, count))
-        count = buf->capacity - buf->cursor, rc = B_FAIL;
-    memset(buf->data + buf->cursor, ch, count);
+        count = bipinned(buf) ? 0 : buf->capacity - buf->cursor, rc = B_FAIL;
+    bifill(buf, buf->cursor, ch, count);
     buf->count = bimax(buf->count, buf->cursor += count);
     *accumulator += count;
     return rc;
 }
 
 int biimmcmp(const char* str, size_t len, BUFFER* buf, int* accumulator) {
-    size_t i; if (len > buf->count - buf->cursor) return B_FAIL;
+    size_t i;
+    if (len > buf->count - buf->cursor && birefill(buf, len)) return B_FAIL;
     for (i = 0; i < len; i++) {
-        if (buf->data[buf->cursor] != str[i]) return B_FAIL;
+        if (*biat(buf, buf->cursor) != (uchar)str[i]) return B_FAIL;
         buf->cursor  += 1;
         *accumulator += 1;
     }
@@ -392,11 +1874,12 @@ int biimmcmp(const char* str, size_t len, BUFFER* buf, int* accumulator) {
 }
 
 int biimmpeek(BUFFER* buf) {
-    return buf->cursor == buf->count ? EOB : buf->data[buf->cursor];
+    if (buf->cursor == buf->count && birefill(buf, 1)) return EOB;
+    return *biat(buf, buf->cursor);
 }
 
 int biimmskip(BUFFER* buf) {
-    if (buf->cursor == buf->count) return B_FAIL;
+    if (buf->cursor == buf->count && birefill(buf, 1)) return B_FAIL;
     ++buf->cursor;
     return B_OKEY;
 }
\ No newline at end of file
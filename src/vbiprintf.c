@@ -154,7 +154,7 @@ static void bihfntostr(double number, char* outbuf, int* exp, bool up) {
 }
 
 static int biputfmt_di(BUFFER* buf, va_list args, bifmtspec_t* fmt, int* total) {
-    static char tmpbuf[B_INTBUF_CAPACITY];
+    char tmpbuf[B_INTBUF_CAPACITY];
     intmax_t received;
     int len, padding;
     bool zerozero;
@@ -211,7 +211,7 @@ static int biputfmt_di(BUFFER* buf, va_list args, bifmtspec_t* fmt, int* total)
 }
 
 static int biputfmt_boux(BUFFER* buf, va_list args, bifmtspec_t* fmt, int* total, char specch) {
-    static char tmpbuf[B_INTBUF_CAPACITY];
+    char tmpbuf[B_INTBUF_CAPACITY];
     int len, prefix_size, padding, base;
     uintmax_t received;
     bool zerozero;
@@ -274,7 +274,7 @@ static int biputfmt_boux(BUFFER* buf, va_list args, bifmtspec_t* fmt, int* total
  */
 
 static int biputfmt_feg(BUFFER* buf, va_list args, bifmtspec_t* fmt, int* total, bool up, int spec) {
-    static char tmpbuf[B_FLTBUF_CAPACITY], expbuf[8];
+    char tmpbuf[B_FLTBUF_CAPACITY], expbuf[8];
     long double received;
     bool normal = false;
     bool fixed = false;
@@ -393,7 +393,7 @@ static int biputfmt_feg(BUFFER* buf, va_list args, bifmtspec_t* fmt, int* total,
 }
 
 static int biputfmt_a(BUFFER* buf, va_list args, bifmtspec_t* fmt, int* total, bool up) {
-    static char tmpbuf[B_FLTBUF_CAPACITY], expbuf[8];
+    char tmpbuf[B_FLTBUF_CAPACITY], expbuf[8];
     long double received;
     bool normal = false;
     bool is_neg, has_sign;
@@ -0,0 +1,70 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BARENA* arena; BUFFER* buf; BOPTIONS opts; BUFVIEW bvw;
+    char data[3000], *first, *ptr, *other;
+    size_t i;
+
+    memset(data, 'x', sizeof data);
+
+    TEST_PCMP("call with null pointer", NULL, ==, barenaalloc(NULL, 10, NULL));
+
+    arena = barenaopen(4096);
+    TEST_PCMP("open arena", NULL, !=, arena);
+
+    /* Allocation */
+
+    first = barenaalloc(NULL, 100, arena);
+    TEST_PCMP("allocate", NULL, !=, first);
+    TEST_ICMP("allocate | aligned", 0, ==, (int)((size_t)first % sizeof(double)));
+    memcpy(first, "data", 4);
+
+    ptr = barenaalloc(first, 2000, arena);
+    TEST_PCMP("grow last in place", first, ==, ptr);
+    ptr = barenaalloc(ptr, 50, arena);
+    TEST_PCMP("shrink last in place", first, ==, ptr);
+
+    other = barenaalloc(NULL, 10, arena);
+    TEST_PCMP("allocate after last", NULL, !=, other);
+    TEST_PCMP("allocate after last", first + 50, <=, other);
+
+    ptr = barenaalloc(first, 1000, arena);
+    TEST_PCMP("grow not last", first, !=, ptr);
+    TEST_MCMP("grow not last | content", "data", ptr, 4);
+
+    ptr = barenaalloc(NULL, 100000, arena);
+    TEST_PCMP("allocate over block", NULL, !=, ptr);
+    memset(ptr, 0, 100000);
+
+    /* Bulk release */
+
+    barenareset(arena);
+    TEST_PCMP("reuse after reset", first, ==, barenaalloc(NULL, 100, arena));
+    barenareset(arena);
+
+    /* Buffers in arena */
+
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w+";
+    opts.allocator = barenaalloc;
+    opts.userdata = arena;
+    buf = bopenex(&opts);
+    TEST_PCMP("open buffer", NULL, !=, buf);
+    for (i = 0; i < 10; i++)
+        bwrite(data, 1, sizeof data, buf);
+    bvw = bview(buf);
+    TEST_ICMP("open buffer | length", 30000, ==, (int)BV_LEN(bvw, base, stop));
+    TEST_MCMP("open buffer | content", data, bvw.base, sizeof data);
+
+    TEST_ICMP("set allocator", 0, ==, bsetalloc(barenaalloc, arena));
+    buf = bopen("some", 4, "r");
+    bsetalloc(NULL, NULL);
+    TEST_PCMP("set allocator", NULL, !=, buf);
+    TEST_ICMP("set allocator | content", 's', ==, bgetc(buf));
+
+    barenareset(arena);
+    barenaclose(arena);
+
+    return EXIT_SUCCESS;
+}
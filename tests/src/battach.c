@@ -0,0 +1,51 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BUFVIEW bvw; char* mem;
+
+    mem = malloc(16);
+    TEST_PCMP("call with null pointer and capacity", NULL, ==, battach(NULL, 0, 16, "r"));
+    TEST_PCMP("call with size over capacity"       , NULL, ==, battach(mem, 17, 16, "r"));
+    TEST_PCMP("call with invalid mode"             , NULL, ==, battach(mem, 4, 16, "m"));
+    TEST_PCMP("call with segmented mode"           , NULL, ==, battach(mem, 4, 16, "rs"));
+    TEST_PCMP("call with null mode"                , NULL, ==, battach(mem, 4, 16, NULL));
+
+    memcpy(mem, "beaver", 6);
+    buf = battach(mem, 6, 16, "r+");
+    bvw = bview(buf);
+    TEST_PCMP("attach for reading", NULL, !=, buf);
+    TEST_PCMP("attach for reading", mem , ==, bvw.base);
+    TEST_ICMP("attach for reading", 6, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("attach for reading", 0, ==, BV_LEN(bvw, base, head));
+
+    bseek(buf, 0, BSEEK_END);
+    bprintf(buf, "%s", " builds a dam of branches");
+    bvw = bview(buf);
+    TEST_ICMP("attach and grow", 31, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("attach and grow", "beaver builds a dam of branches", bvw.base, 31);
+    bclose(buf);
+
+    mem = malloc(16);
+    buf = battach(mem, 16, 16, "w");
+    bvw = bview(buf);
+    TEST_ICMP("attach for writing", 0, ==, BV_LEN(bvw, base, stop));
+    bclose(buf);
+
+    mem = malloc(16);
+    memcpy(mem, "beaver", 6);
+    buf = battach(mem, 6, 16, "a");
+    bvw = bview(buf);
+    TEST_ICMP("attach for appending", 6, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("attach for appending", 6, ==, BV_LEN(bvw, base, head));
+    bclose(buf);
+
+    buf = battach(NULL, 0, 0, "w");
+    TEST_PCMP("attach nothing", NULL, !=, buf);
+    bputs("text", buf);
+    bvw = bview(buf);
+    TEST_MCMP("attach nothing", "text", bvw.base, 4);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static const char text[] = "key = 42\nname = beaver\n";
+    BUFFER* buf; BUFVIEW bvw;
+    char line[16], name[16]; int value;
+
+    TEST_PCMP("call with null pointer", NULL, ==, bborrow(NULL, 4));
+
+    buf = bborrow(NULL, 0);
+    TEST_PCMP("borrow nothing", NULL, !=, buf);
+    TEST_ICMP("borrow nothing", EOB, ==, bgetc(buf));
+    bclose(buf);
+
+    buf = bborrow(text, sizeof text - 1);
+    bvw = bview(buf);
+    TEST_PCMP("borrow without copy", text, ==, bvw.base);
+    TEST_ICMP("borrow without copy", sizeof text - 1, ==, BV_LEN(bvw, base, stop));
+
+    TEST_ICMP("read only", EOB, ==, bputc('x', buf));
+    TEST_ICMP("read only", 0, !=, berase(buf, 1));
+    TEST_ICMP("read only", 0, !=, breset(buf));
+    TEST_PCMP("read only", NULL, ==, bdetach(buf, NULL));
+
+    TEST_ICMP("scan borrowed", 1, ==, bscanf(buf, "key = %d\n", &value));
+    TEST_ICMP("scan borrowed", 42, ==, value);
+    TEST_PCMP("gets borrowed", line, ==, bgets(line, sizeof line, buf));
+    TEST_SCMP("gets borrowed", "name = beaver\n", line);
+
+    bseek(buf, 14, BSEEK_SET);
+    TEST_ICMP("unget same byte", ' ', ==, bungetc(' ', buf));
+    TEST_ICMP("unget other byte", EOB, ==, bungetc('x', buf));
+    TEST_ICMP("unget other byte", 13, ==, (int)btell(buf));
+    TEST_ICMP("scan after unget", 1, ==, bscanf(buf, " = %15s", name));
+    TEST_SCMP("scan after unget", "beaver", name);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char big[5000];
+    BPOOL* pool; BCACHE* cache; BUFFER *bufs[20], *buf, *other, *again;
+    int i, found; size_t avail = 0;
+
+    TEST_PCMP("call with null pointer", NULL, ==, bcacheopen(NULL));
+    TEST_PCMP("call with null pointer", NULL, ==, bcacheget(NULL, 0, "w"));
+    TEST_ICMP("call with null pointer", EOB, ==, bcacheput(NULL, NULL));
+
+    pool  = bpoolopen(1 << 20);
+    cache = bcacheopen(pool);
+    TEST_PCMP("open cache", NULL, !=, cache);
+    TEST_PCMP("call with reading mode", NULL, ==, bcacheget(cache, 0, "r"));
+
+    buf = bcacheget(cache, 10, "w");
+    bputs("data", buf);
+    bwrite(big, 1, sizeof big, buf);
+    bcacheput(cache, buf);
+    TEST_PCMP("get with invalid mode", NULL, ==, bcacheget(cache, 4000, "wx"));
+    TEST_PCMP("get recycled", buf, ==, bcacheget(cache, 4000, "w+"));
+    TEST_PCMP("get recycled | capacity", NULL, !=, bwritebegin(buf, 0, &avail));
+    TEST_ICMP("get recycled | capacity", (int)sizeof big, <=, (int)avail);
+    TEST_ICMP("get recycled | empty", EOB, ==, bgetc(buf));
+    bcacheput(cache, buf);
+
+    /* Overflow of cache goes to pool */
+
+    for (i = 0; i < 20; i++)
+        bufs[i] = bcacheget(cache, 1024, "w");
+    for (i = 0; i < 20; i++)
+        bcacheput(cache, bufs[i]);
+
+    /* first half of full cache is spilled at next put */
+    buf = bufs[7];
+    for (found = i = 0; i < 20; i++) {
+        bufs[i] = bpoolget(pool, 1024, "w");
+        found += bufs[i] == buf;
+    }
+    TEST_ICMP("overflow to pool", 1, ==, found);
+    for (i = 0; i < 20; i++)
+        bpoolput(pool, bufs[i]);
+
+    bcacheclose(cache);
+    bpoolclose(pool);
+
+    /* Cached buffers are counted in limit of pool */
+
+    pool  = bpoolopen(1500);
+    cache = bcacheopen(pool);
+    buf   = bcacheget(cache, 0, "w");
+    other = bpoolget(pool, 0, "w");
+    bcacheput(cache, buf);
+    bpoolput(pool, other);
+    again = bopen(NULL, 0, "w"); /* may take memory of closed buffer */
+    other = bpoolget(pool, 0, "w");
+    TEST_PCMP("limit of retained", NULL, !=, other);
+    TEST_PCMP("limit of retained", again, !=, other);
+    TEST_PCMP("limit of retained", buf, ==, bcacheget(cache, 0, "w"));
+    TEST_ICMP("limit of retained | put to cache", 0, ==, bcacheput(cache, buf));
+    TEST_ICMP("limit of retained | put to cache", 0, ==, bcacheput(cache, other));
+    TEST_PCMP("limit of retained | put to cache", buf, ==, bcacheget(cache, 0, "w"));
+    bclose(again);
+    bclose(buf);
+    bcacheclose(cache);
+    bpoolclose(pool);
+
+    return EXIT_SUCCESS;
+}
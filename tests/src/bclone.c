@@ -0,0 +1,80 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+static void* failing(void* ptr, size_t size, void* ud) {
+    if (size && *(int*)ud) return NULL;
+    if (size) return realloc(ptr, size);
+    free(ptr);
+    return NULL;
+}
+
+int main(void) {
+    BUFFER *buf, *first, *second; BUFVIEW bvw;
+    char base[8], str[16]; BOPTIONS opts = {0}; BUFVEC vec; int fail = 0;
+
+    TEST_PCMP("call with null pointer", NULL, ==, bclone(NULL));
+
+    buf = bmemopen(base, sizeof base, "w");
+    TEST_PCMP("call with fixed buffer", NULL, ==, bclone(buf));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w+");
+    bputs("response", buf);
+    first = bclone(buf);
+    second = bclone(first);
+    TEST_PCMP("clone", NULL, !=, first);
+    TEST_PCMP("clone of clone", NULL, !=, second);
+
+    /* Shared storage */
+
+    bvw = bview(first);
+    TEST_PCMP("clone | shared storage", bview(buf).base, ==, bvw.base);
+    TEST_PCMP("clone | shared storage", bview(second).base, ==, bvw.base);
+    TEST_ICMP("clone | length", 8, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("clone | own position", 0, ==, BV_LEN(bvw, base, head));
+    TEST_ICMP("clone | read", 'r', ==, bgetc(first));
+    TEST_ICMP("clone | own position", 'r', ==, bgetc(second));
+
+    /* Copy on write */
+
+    TEST_ICMP("write to clone", 0, ==, bputs("R", second));
+    TEST_PCMP("write to clone | copied", bview(buf).base, !=, bview(second).base);
+    TEST_SCMP("write to clone | others", "response", bgets(str, sizeof str, (brewind(first), first)));
+    brewind(second);
+    TEST_SCMP("write to clone | content", "rRsponse", bgets(str, sizeof str, second));
+
+    TEST_ICMP("unget same byte", 'e', ==, bungetc('e', first));
+    TEST_PCMP("unget same byte | shared", bview(buf).base, ==, bview(first).base);
+
+    bclose(buf);
+    TEST_ICMP("erase in clone", 0, ==, berase((brewind(first), first), 1));
+    TEST_SCMP("erase in clone", "esponse", bgets(str, sizeof str, first));
+    bclose(second);
+    bclose(first);
+
+    /* Failed copy */
+
+    vec.base = str;
+    vec.size = 2;
+    opts.mode = "w+";
+    opts.allocator = failing;
+    opts.userdata = &fail;
+    buf = bopenex(&opts);
+    bputs("shared", buf);
+    first = bclone(buf);
+    fail = 1;
+    TEST_ICMP("failed copy | bputc", EOB, ==, bputc('x', first));
+    TEST_ICMP("failed copy | bputs", EOB, ==, bputs("xy", first));
+    TEST_ICMP("failed copy | bwrite", 0, ==, (int)bwrite("xy", 1, 2, first));
+    TEST_ICMP("failed copy | bwritev", 0, ==, (int)bwritev(first, &vec, 1));
+    TEST_ICMP("failed copy | bprintf", 0, ==, bprintf(first, "%s", "xy"));
+    TEST_ICMP("failed copy | bprintf", 0, ==, bprintf(first, "%5c", 'x'));
+    TEST_ICMP("failed copy | breset", 0, !=, breset(first));
+    TEST_PCMP("failed copy | shared", bview(buf).base, ==, bview(first).base);
+    TEST_SCMP("failed copy | content", "shared", bgets(str, sizeof str, first));
+    fail = 0;
+    bclose(first);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
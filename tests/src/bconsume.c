@@ -0,0 +1,31 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf;
+
+    TEST_ICMP("call with null pointer", 0, !=, bconsume(NULL, 0));
+
+    buf = bopen(NULL, 0, "w+");
+    TEST_ICMP("call with not allocated data", 0, !=, bconsume(buf, 0));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "a");
+    TEST_ICMP("call with not readable", 0, !=, bconsume(buf, 0));
+    bclose(buf);
+
+    buf = bopen("Two words", 9, "r");
+    TEST_ICMP("consume part", 0, ==, bconsume(buf, 4));
+    TEST_ICMP("consume part", 4, ==, (int)btell(buf));
+    TEST_ICMP("consume part", 'w', ==, bgetc(buf));
+
+    TEST_ICMP("consume too much", 0, !=, bconsume(buf, 5));
+    TEST_ICMP("consume too much", 5, ==, (int)btell(buf));
+
+    TEST_ICMP("consume rest", 0, ==, bconsume(buf, 4));
+    TEST_ICMP("consume rest", 0, !=, beob(buf));
+    TEST_ICMP("consume nothing", 0, ==, bconsume(buf, 0));
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
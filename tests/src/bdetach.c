@@ -0,0 +1,62 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char big[100000];
+    BUFFER* buf; BUFVIEW bvw;
+    char* mem, local[16]; size_t size;
+
+    TEST_PCMP("call with null pointer", NULL, ==, bdetach(NULL, &size));
+
+    buf = bopen(NULL, 0, "w");
+    TEST_PCMP("call with not allocated data", NULL, ==, bdetach(buf, &size));
+    bclose(buf);
+
+    buf = bmemopen(local, sizeof local, "w+");
+    bputs("data", buf);
+    TEST_PCMP("call with memory of caller", NULL, ==, bdetach(buf, &size));
+    TEST_ICMP("call with memory of caller", 'd', ==, (brewind(buf), bgetc(buf)));
+    bclose(buf);
+
+    buf = bmemopen(NULL, 16, "w+");
+    bputs("data", buf);
+    mem = bdetach(buf, &size);
+    TEST_PCMP("detach allocated by bmemopen", NULL, !=, mem);
+    TEST_MCMP("detach allocated by bmemopen", "data", mem, 4);
+    free(mem);
+
+    buf = bopen(NULL, 0, "w");
+    bprintf(buf, "%d-%s", 42, "answer");
+    bvw = bview(buf);
+    mem = bdetach(buf, &size);
+    TEST_PCMP("detach storage", bvw.base, ==, mem);
+    TEST_ICMP("detach storage", 9, ==, (int)size);
+    TEST_MCMP("detach storage", "42-answer", mem, 9);
+    free(mem);
+
+    mem = malloc(8);
+    memcpy(mem, "beaver", 6);
+    buf = battach(mem, 6, 8, "r+q");
+    berase(buf, 2);
+    TEST_PCMP("detach in queue mode", mem, ==, bdetach(buf, &size));
+    TEST_ICMP("detach in queue mode", 4, ==, (int)size);
+    TEST_MCMP("detach in queue mode", "aver", mem, 4);
+    free(mem);
+
+    buf = bopen("beer", 4, "r+g");
+    bseek(buf, 2, BSEEK_SET);
+    binsert("av", 2, buf);
+    mem = bdetach(buf, NULL);
+    TEST_MCMP("detach in gap mode", "beaver", mem, 6);
+    free(mem);
+
+    memset(big, 'z', sizeof big);
+    buf = bopen(big, sizeof big, "rs");
+    mem = bdetach(buf, &size);
+    TEST_PCMP("detach in segmented mode", NULL, !=, mem);
+    TEST_ICMP("detach in segmented mode", sizeof big, ==, (int)size);
+    TEST_MCMP("detach in segmented mode", big, mem, sizeof big);
+    free(mem);
+
+    return EXIT_SUCCESS;
+}
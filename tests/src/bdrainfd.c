@@ -0,0 +1,94 @@
+#define _POSIX_C_SOURCE 200112L
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+/* read everything available from non-blocking fd */
+static size_t readall(int fd, char* dest, size_t size) {
+    size_t total = 0; ssize_t got;
+    while (total < size && (got = read(fd, dest + total, size - total)) > 0)
+        total += got;
+    return total;
+}
+
+int main(void) {
+    static char big[100000], back[100000];
+    BUFFER* buf; BUFVIEW bvw; size_t i;
+    int fds[2]; long got, total;
+
+    TEST_ICMP("call with null pointer", EOB, ==, bdrainfd(NULL, 0));
+
+    buf = bopen("Text", 4, "a");
+    TEST_ICMP("call with not readable", EOB, ==, bdrainfd(buf, 0));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with bad fd", EOB, ==, bdrainfd(buf, -1));
+    TEST_ICMP("call with bad fd", 0, ==, (int)btell(buf));
+    bclose(buf);
+
+    if (pipe(fds)) return EXIT_FAILURE;
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+    buf = bopen("head body", 9, "r");
+    bseek(buf, 5, BSEEK_SET);
+    TEST_ICMP("drain unread", 4, ==, bdrainfd(buf, fds[1]));
+    TEST_ICMP("drain unread", 9, ==, (int)btell(buf));
+    TEST_ICMP("drain unread", 4, ==, (int)readall(fds[0], back, sizeof back));
+    TEST_MCMP("drain unread", "body", back, 4);
+    TEST_ICMP("drain at end", 0, ==, bdrainfd(buf, fds[1]));
+    bclose(buf);
+
+    /* Short writes */
+
+    for (i = 0; i < sizeof big; i++)
+        big[i] = (char)('a' + i % 26);
+    buf = bopen(big, sizeof big, "r");
+    got = bdrainfd(buf, fds[1]);
+    TEST_ICMP("drain to full pipe", 0, <, got);
+    TEST_ICMP("drain to full pipe", (int)sizeof big, >, (int)got);
+    TEST_ICMP("drain to full pipe", (int)got, ==, (int)btell(buf));
+    TEST_ICMP("drain without space", EOB, ==, bdrainfd(buf, fds[1]));
+    TEST_ICMP("drain without space", EAGAIN, ==, errno);
+
+    for (total = 0, i = 0; total < (long)sizeof big && i < 100; i++) {
+        total += readall(fds[0], back + total, sizeof back - total);
+        bdrainfd(buf, fds[1]);
+    }
+    TEST_ICMP("drain by parts", (int)sizeof big, ==, (int)btell(buf));
+    TEST_MCMP("drain by parts", big, back, sizeof big);
+    bclose(buf);
+
+    /* Queue mode */
+
+    buf = bopen(NULL, 0, "w+q");
+    bputs("message", buf);
+    brewind(buf);
+    TEST_ICMP("drain queue", 7, ==, bdrainfd(buf, fds[1]));
+    bvw = bview(buf);
+    TEST_ICMP("drain queue | written are erased", 0, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("drain queue", 7, ==, (int)readall(fds[0], back, sizeof back));
+    TEST_MCMP("drain queue", "message", back, 7);
+    bclose(buf);
+
+    close(fds[0]);
+    close(fds[1]);
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(void) {
+    BUFFER* buf = bopen("Text", 4, "r");
+    TEST_ICMP("not supported", EOB, ==, bdrainfd(buf, 0));
+    bclose(buf);
+    return EXIT_SUCCESS;
+}
+
+#endif
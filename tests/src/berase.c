@@ -3,6 +3,7 @@
 
 int main(void) {
     BUFFER* buf; BUFVIEW bvw; int ret;
+    char tmpstr[16];
 
     /* Wrong usage */
 
@@ -91,5 +92,99 @@ int main(void) {
     TEST_ICMP("remove from end | nonzero length", 6, ==, BV_LEN(bvw, base, head));
     bclose(buf);
 
+    /* Gap mode */
+
+    buf = bopen("beaver", 6, "r+g");
+    bseek(buf, 2, BSEEK_SET);
+    ret = berase(buf, 1);
+    ret = berase(buf, 1) || ret;
+    bseek(buf, 0, BSEEK_SET);
+    ret = berase(buf, 1) || ret;
+    bvw = bview(buf);
+    TEST_ICMP("gap | remove in several places", 0, ==, ret);
+    TEST_ICMP("gap | remove in several places", 3, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("gap | remove in several places", 0, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("gap | remove in several places", "eer", bvw.base, 3);
+
+    bseek(buf, 2, BSEEK_SET);
+    binsert("ag", 2, buf);
+    bseek(buf, -3, BSEEK_CUR);
+    ret = berase(buf, 2);
+    bvw = bview(buf);
+    TEST_ICMP("gap | remove after insert", 0, ==, ret);
+    TEST_ICMP("gap | remove after insert", 3, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("gap | remove after insert", 1, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("gap | remove after insert", "egr", bvw.base, 3);
+    bclose(buf);
+
+    /* Queue mode */
+
+    buf = bopen("beaver", 6, "r+q");
+    ret = berase(buf, 2);
+    bvw = bview(buf);
+    TEST_ICMP("queue | remove from start", 0, ==, ret);
+    TEST_ICMP("queue | remove from start", 4, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("queue | remove from start", 0, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("queue | remove from start", "aver", bvw.base, 4);
+
+    bseek(buf, 1, BSEEK_SET);
+    ret = berase(buf, 1);
+    bvw = bview(buf);
+    TEST_ICMP("queue | remove near start", 0, ==, ret);
+    TEST_ICMP("queue | remove near start", 3, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("queue | remove near start", 1, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("queue | remove near start", "aer", bvw.base, 3);
+
+    bseek(buf, 2, BSEEK_SET);
+    ret = berase(buf, 1);
+    bvw = bview(buf);
+    TEST_ICMP("queue | remove near end", 0, ==, ret);
+    TEST_ICMP("queue | remove near end", 2, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("queue | remove near end", 2, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("queue | remove near end", "ae", bvw.base, 2);
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w+q");
+    {
+        int i; char msg[8];
+        for (i = 0; i < 10000; i++) {
+            bseek(buf, 0, BSEEK_END);
+            bprintf(buf, "%07d", i);
+            if (i % 3 != 2) continue;
+            brewind(buf);
+            bread(msg, 1, 7, buf);
+            brewind(buf);
+            berase(buf, 7);
+            sprintf(tmpstr, "%07d", i / 3);
+            TEST_MCMP("queue | fifo usage", tmpstr, msg, 7);
+        }
+        bvw = bview(buf);
+        TEST_ICMP("queue | fifo usage", 7 * (10000 - 3333), ==, BV_LEN(bvw, base, stop));
+        TEST_MCMP("queue | fifo usage", "0003333", bvw.base, 7);
+    }
+    bclose(buf);
+
+    /* Segmented mode */
+
+    {
+    static char big[150000];
+    BUFSPAN spans[3]; size_t i;
+
+    for (i = 0; i < sizeof big; i++)
+        big[i] = (char)(i % 251);
+
+    buf = bopen(big, sizeof big, "r+s");
+    bseek(buf, 60000, BSEEK_SET);
+    ret = berase(buf, 10000);
+    memmove(big + 60000, big + 70000, sizeof big - 70000);
+    TEST_ICMP("segmented | remove over blocks", 0, ==, ret);
+    TEST_ICMP("segmented | remove over blocks", 3, ==, (int)bviewv(buf, spans, 3));
+    TEST_MCMP("segmented | remove over blocks", big, spans[0].base, 65536);
+    TEST_MCMP("segmented | remove over blocks", big + 65536, spans[1].base, 65536);
+    TEST_ICMP("segmented | remove over blocks", sizeof big - 10000 - 131072, ==, (int)spans[2].size);
+    TEST_MCMP("segmented | remove over blocks", big + 131072, spans[2].base, spans[2].size);
+    bclose(buf);
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
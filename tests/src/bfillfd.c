@@ -0,0 +1,82 @@
+#define _POSIX_C_SOURCE 200112L
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+int main(void) {
+    static char big[65600];
+    BUFFER* buf; BUFVIEW bvw; BUFSPAN spans[2];
+    char base[8]; int fds[2];
+
+    TEST_ICMP("call with null pointer", EOB, ==, bfillfd(NULL, 0, 1));
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with not writable", EOB, ==, bfillfd(buf, 0, 1));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w+");
+    TEST_ICMP("call with zero max", EOB, ==, bfillfd(buf, 0, 0));
+    TEST_ICMP("call with bad fd"  , EOB, ==, bfillfd(buf, -1, 1));
+    bclose(buf);
+
+    if (pipe(fds)) return EXIT_FAILURE;
+    write(fds[1], "hello world", 11);
+
+    buf = bopen("> ", 2, "r+");
+    TEST_ICMP("fill less than available", 5, ==, bfillfd(buf, fds[0], 5));
+    TEST_ICMP("fill greater than available", 6, ==, bfillfd(buf, fds[0], 100));
+    bvw = bview(buf);
+    TEST_ICMP("fill | position is kept", 0, ==, BV_LEN(bvw, base, head));
+    TEST_ICMP("fill | content", 13, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("fill | content", "> hello world", bvw.base, 13);
+
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    TEST_ICMP("fill without data", EOB, ==, bfillfd(buf, fds[0], 100));
+    TEST_ICMP("fill without data", EAGAIN, ==, errno);
+    bclose(buf);
+
+    /* Fixed buffer */
+
+    write(fds[1], "0123456789", 8);
+    buf = bmemopen(base, sizeof base, "w+");
+    TEST_ICMP("fill fixed", 8, ==, bfillfd(buf, fds[0], 100));
+    TEST_ICMP("fill fixed | full", EOB, ==, bfillfd(buf, fds[0], 100));
+    TEST_MCMP("fill fixed", "01234567", base, 8);
+    bclose(buf);
+
+    /* Segmented mode */
+
+    memset(big, 'x', sizeof big);
+    buf = bopen(NULL, 0, "w+s");
+    bwrite(big, 1, 65530, buf);
+    write(fds[1], "0123456789", 10);
+    TEST_ICMP("fill segmented", 10, ==, bfillfd(buf, fds[0], 100));
+    TEST_ICMP("fill segmented", 2, ==, (int)bviewv(buf, spans, 2));
+    TEST_MCMP("fill segmented", "xx012345", (const char*)spans[0].base + 65528, 8);
+    TEST_MCMP("fill segmented", "6789", spans[1].base, 4);
+    bclose(buf);
+
+    close(fds[1]);
+    buf = bopen(NULL, 0, "w+");
+    TEST_ICMP("fill at end of file", 0, ==, bfillfd(buf, fds[0], 100));
+    bclose(buf);
+    close(fds[0]);
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(void) {
+    BUFFER* buf = bopen(NULL, 0, "w+");
+    TEST_ICMP("not supported", EOB, ==, bfillfd(buf, 0, 1));
+    bclose(buf);
+    return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,33 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BUFVIEW bvw;
+    char base[8];
+
+    TEST_ICMP("call with null pointer", 0, !=, bfreeze(NULL));
+
+    buf = bmemopen(base, sizeof base, "w");
+    TEST_ICMP("call with fixed buffer", 0, !=, bfreeze(buf));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "ws");
+    TEST_ICMP("call with segmented buffer", 0, !=, bfreeze(buf));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "r+g");
+    bseek(buf, 2, BSEEK_SET);
+    binsert("--", 2, buf);
+    TEST_ICMP("freeze", 0, ==, bfreeze(buf));
+    TEST_ICMP("freeze | again", 0, ==, bfreeze(buf));
+    TEST_ICMP("freeze | no sink", 0, !=, bsetsink(buf, NULL, NULL, 0));
+    bvw = bview(buf);
+    TEST_MCMP("freeze | content", "Te--xt", bvw.base, 6);
+
+    /* the only owner writes without copying */
+    TEST_ICMP("write after freeze", 0, ==, bputs("!", buf));
+    TEST_PCMP("write after freeze | same storage", bvw.base, ==, bview(buf).base);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -47,5 +47,21 @@ int main(void) {
 
     bclose(buf);
 
+    /* Segmented mode */
+
+    {
+    static char lines[70000];
+    memset(lines, '-', sizeof lines);
+    memcpy(lines + 65532, "\nacross\nrest", 13);
+
+    buf = bopen(lines, sizeof lines, "rs");
+    bseek(buf, 65533, BSEEK_SET);
+    TEST_PCMP("segmented | line over blocks", dest, ==, bgets(dest, sizeof dest, buf));
+    TEST_SCMP("segmented | line over blocks", "across\n", dest);
+    TEST_PCMP("segmented | line over blocks", dest, ==, bgets(dest, 5, buf));
+    TEST_SCMP("segmented | line over blocks", "rest", dest);
+    bclose(buf);
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BUFVIEW bvw;
+    char base[8];
+
+    TEST_ICMP("call with null pointer", 0, !=, binsert(NULL, 0, NULL));
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with not writable", 0, !=, binsert("a", 1, buf));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "r+");
+    TEST_ICMP("call with null source pointer", 0, !=, binsert(NULL, 1, buf));
+    TEST_ICMP("call with zero size"          , 0, !=, binsert( "" , 0, buf));
+    bclose(buf);
+
+    /* Plain mode */
+
+    buf = bopen("beer", 4, "r+");
+    bseek(buf, 2, BSEEK_SET);
+    TEST_ICMP("insert to middle", 0, ==, binsert("av", 2, buf));
+    bvw = bview(buf);
+    TEST_ICMP("insert to middle", 6, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("insert to middle", 4, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("insert to middle", "beaver", bvw.base, 6);
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w");
+    TEST_ICMP("insert to empty", 0, ==, binsert("ver", 3, buf));
+    brewind(buf);
+    TEST_ICMP("insert to start", 0, ==, binsert("bea", 3, buf));
+    bvw = bview(buf);
+    TEST_ICMP("insert to start", 6, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("insert to start", 3, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("insert to start", "beaver", bvw.base, 6);
+    bclose(buf);
+
+    buf = bmemopen(base, sizeof base, "w+");
+    bputs("beer", buf);
+    TEST_ICMP("insert to fixed | overflow", 0, !=, binsert("overflow", 8, buf));
+    bseek(buf, 2, BSEEK_SET);
+    TEST_ICMP("insert to fixed | fit", 0, ==, binsert("av", 2, buf));
+    bvw = bview(buf);
+    TEST_ICMP("insert to fixed | fit", 6, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("insert to fixed | fit", "beaver", base, 6);
+    bclose(buf);
+
+    /* Gap mode */
+
+    buf = bopen("beer", 4, "r+g");
+    bseek(buf, 2, BSEEK_SET);
+    TEST_ICMP("gap | insert to middle", 0, ==, binsert("a", 1, buf));
+    TEST_ICMP("gap | insert to middle", 0, ==, binsert("v", 1, buf));
+    TEST_ICMP("gap | insert to middle", 4, ==, (int)btell(buf));
+    bvw = bview(buf);
+    TEST_ICMP("gap | insert to middle", 6, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("gap | insert to middle", 4, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("gap | insert to middle", "beaver", bvw.base, 6);
+
+    bseek(buf, 1, BSEEK_SET);
+    binsert("r", 1, buf);
+    bseek(buf, 6, BSEEK_SET);
+    binsert("s", 1, buf);
+    bseek(buf, 0, BSEEK_END);
+    binsert("!", 1, buf);
+    bseek(buf, 2, BSEEK_SET);
+    TEST_ICMP("gap | read after edits", 'e', ==, bgetc(buf));
+    bvw = bview(buf);
+    TEST_ICMP("gap | edits with moving", 9, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("gap | edits with moving", "breavesr!", bvw.base, 9);
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w+g");
+    {
+        int i;
+        for (i = 0; i < 3000; i++) {
+            binsert("xy", 2, buf);
+            bseek(buf, -1, BSEEK_CUR);
+        }
+        bvw = bview(buf);
+        TEST_ICMP("gap | many inserts", 6000, ==, BV_LEN(bvw, base, stop));
+        TEST_ICMP("gap | many inserts", 3000, ==, BV_LEN(bvw, base, head));
+        TEST_MCMP("gap | many inserts", "xxyyy", (char*)bvw.base + 2998, 5);
+    }
+    bclose(buf);
+
+    /* Segmented mode */
+
+    {
+    static char big[100000], back[100005];
+    size_t i;
+
+    for (i = 0; i < sizeof big; i++)
+        big[i] = (char)(i % 251);
+
+    buf = bopen(big, sizeof big, "r+s");
+    bseek(buf, 65534, BSEEK_SET);
+    TEST_ICMP("segmented | insert over blocks", 0, ==, binsert("12345", 5, buf));
+    brewind(buf);
+    TEST_ICMP("segmented | insert over blocks", sizeof back, ==, (int)bread(back, 1, sizeof back, buf));
+    TEST_MCMP("segmented | insert over blocks", big, back, 65534);
+    TEST_MCMP("segmented | insert over blocks", "12345", back + 65534, 5);
+    TEST_MCMP("segmented | insert over blocks", big + 65534, back + 65539, sizeof big - 65534);
+    bclose(buf);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BUFVIEW bvw;
+    char text[16]; int num;
+
+    TEST_PCMP("create | with ring"      , NULL, ==, bopen(NULL, 0, "w+cl"));
+    TEST_PCMP("create | with concurrent", NULL, ==, bopen(NULL, 0, "w+lm"));
+    TEST_PCMP("create | repeated flag"  , NULL, ==, bopen(NULL, 0, "w+ll"));
+
+    buf = bopen(NULL, 0, "w+gl");
+    TEST_PCMP("create", NULL, !=, buf);
+
+    /* Locking functions */
+
+    TEST_ICMP("put char"  , 'a', ==, bputc('a', buf));
+    TEST_ICMP("put string", 0  , ==, bputs("bc ", buf));
+    TEST_ICMP("write"     , 3  , ==, (int)bwrite("de ", 1, 3, buf));
+    TEST_ICMP("print"     , 5  , ==, bprintf(buf, "%d %s", 12, "fg"));
+
+    /* Batch under lock */
+
+    block(buf);
+    TEST_ICMP("unlocked | put char"  , '\n', ==, bputc_unlocked('\n', buf));
+    TEST_ICMP("unlocked | put string", 0   , ==, bputs_unlocked("hi ", buf));
+    TEST_ICMP("unlocked | write"     , 2   , ==, (int)bwrite_unlocked("jk", 1, 2, buf));
+    TEST_ICMP("unlocked | print"     , 3   , ==, bprintf_unlocked(buf, " %d", 34));
+    brewind(buf);
+    TEST_ICMP("unlocked | get char"  , 'a' , ==, bgetc_unlocked(buf));
+    TEST_PCMP("unlocked | get string", NULL, !=, bgets_unlocked(text, 4, buf));
+    TEST_SCMP("unlocked | get string", "bc ", text);
+    TEST_ICMP("unlocked | read"      , 3   , ==, (int)bread_unlocked(text, 1, 3, buf));
+    TEST_MCMP("unlocked | read"      , "de ", text, 3);
+    TEST_ICMP("unlocked | scan"      , 2   , ==, bscanf_unlocked(buf, "%d %2s", &num, text));
+    TEST_ICMP("unlocked | scan"      , 12  , ==, num);
+    bunlock(buf);
+
+    TEST_ICMP("after unlock | get char"  , '\n', ==, bgetc(buf));
+    TEST_PCMP("after unlock | get string", NULL, !=, bgets(text, 4, buf));
+    TEST_SCMP("after unlock | get string", "hi ", text);
+    TEST_ICMP("after unlock | read"      , 2   , ==, (int)bread(text, 1, 2, buf));
+    TEST_ICMP("after unlock | scan"      , 1   , ==, bscanf(buf, "%d", &num));
+    TEST_ICMP("after unlock | scan"      , 34  , ==, num);
+
+    bvw = bview(buf);
+    TEST_MCMP("content", "abc de 12 fg\nhi jk 34", bvw.base, BV_LEN(bvw, base, stop));
+    bclose(buf);
+
+    /* Lock of buffer without flag */
+
+    buf = bopen(NULL, 0, "w+");
+    block(buf);
+    TEST_ICMP("without flag | put char", 'x', ==, bputc('x', buf));
+    bunlock(buf);
+    bclose(buf);
+
+    block(NULL);
+    bunlock(NULL);
+
+    return EXIT_SUCCESS;
+}
@@ -62,6 +62,8 @@ int main(void) {
     TEST_PCMP("create invalid | partly incorrect 2", NULL, ==, buf);
     buf = bmemopen(NULL, 0, "+a");
     TEST_PCMP("create invalid | incorrect order"   , NULL, ==, buf);
+    buf = bmemopen(NULL, 0, "ws");
+    TEST_PCMP("create invalid | segmented"         , NULL, ==, buf);
 
     /* Read mode */
 
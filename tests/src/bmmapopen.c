@@ -0,0 +1,89 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#define TMPFILE "bmmapopen_" TOSTR(__STDC_VERSION__) ".tmp"
+
+static size_t readfile(char* dest, size_t size) {
+    FILE* file = fopen(TMPFILE, "rb");
+    size_t len = fread(dest, 1, size, file);
+    fclose(file);
+    return len;
+}
+
+int main(void) {
+    static char big[100000], back[100100];
+    BUFFER* buf; BUFVIEW bvw;
+    char word[16]; int num; size_t i;
+
+    TEST_PCMP("call with null path", NULL, ==, bmmapopen(NULL, "r"));
+    TEST_PCMP("call with null mode", NULL, ==, bmmapopen(TMPFILE, NULL));
+    TEST_PCMP("call with flags"    , NULL, ==, bmmapopen(TMPFILE, "ws"));
+
+    remove(TMPFILE);
+    TEST_PCMP("read not existing", NULL, ==, bmmapopen(TMPFILE, "r"));
+
+    /* Write mode */
+
+    buf = bmmapopen(TMPFILE, "w");
+    TEST_PCMP("create file", NULL, !=, buf);
+    TEST_ICMP("create file", 13, ==, bprintf(buf, "%s %d\n", "answer", 42000));
+    TEST_ICMP("sync file", 0, ==, bsync(buf));
+    TEST_ICMP("close file", 0, ==, bclose(buf));
+    TEST_ICMP("content of file", 13, ==, (int)readfile(back, sizeof back));
+    TEST_MCMP("content of file", "answer 42000\n", back, 13);
+
+    /* Read mode */
+
+    buf = bmmapopen(TMPFILE, "r");
+    TEST_PCMP("map for reading", NULL, !=, buf);
+    TEST_ICMP("map for reading", 2, ==, bscanf(buf, "%15s %d", word, &num));
+    TEST_SCMP("map for reading", "answer", word);
+    TEST_ICMP("map for reading", 42000, ==, num);
+    TEST_ICMP("map for reading", EOB, ==, bputc('x', buf));
+    TEST_ICMP("map for reading", EOB, ==, bungetc('x', buf));
+    TEST_ICMP("map for reading", '0', ==, bungetc('0', buf));
+    bclose(buf);
+
+    /* Append and grow */
+
+    for (i = 0; i < sizeof big; i++)
+        big[i] = (char)('a' + i % 26);
+
+    buf = bmmapopen(TMPFILE, "a+");
+    TEST_PCMP("map for appending", NULL, !=, buf);
+    TEST_ICMP("map for appending", 13, ==, (int)btell(buf));
+    TEST_ICMP("grow file", 100, ==, (int)bwrite(big, 1000, 100, buf));
+    bvw = bview(buf);
+    TEST_ICMP("grow file", 13 + sizeof big, ==, BV_LEN(bvw, base, stop));
+    bclose(buf);
+
+    TEST_ICMP("content after growth", 13 + sizeof big, ==, (int)readfile(back, sizeof back));
+    TEST_MCMP("content after growth", "answer 42000\n", back, 13);
+    TEST_MCMP("content after growth", big, back + 13, sizeof big);
+
+    /* Read/write mode */
+
+    buf = bmmapopen(TMPFILE, "r+");
+    bseek(buf, 7, BSEEK_SET);
+    bputs("73", buf);
+    bseek(buf, 13, BSEEK_SET);
+    berase(buf, sizeof big);
+    bclose(buf);
+
+    TEST_ICMP("content after edit", 13, ==, (int)readfile(back, sizeof back));
+    TEST_MCMP("content after edit", "answer 73000\n", back, 13);
+
+    remove(TMPFILE);
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(void) {
+    TEST_PCMP("not supported", NULL, ==, bmmapopen("file", "r"));
+    return EXIT_SUCCESS;
+}
+
+#endif
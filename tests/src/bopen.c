@@ -54,6 +54,12 @@ int main(void) {
     TEST_PCMP("create invalid | partly incorrect 2", NULL, ==, buf);
     buf = bopen(NULL, 0, "+a");
     TEST_PCMP("create invalid | incorrect order"   , NULL, ==, buf);
+    buf = bopen(NULL, 0, "wqq");
+    TEST_PCMP("create invalid | repeated flag"     , NULL, ==, buf);
+    buf = bopen(NULL, 0, "wq+");
+    TEST_PCMP("create invalid | flag before plus"  , NULL, ==, buf);
+    buf = bopen(NULL, 0, "wgs");
+    TEST_PCMP("create invalid | conflicting flags" , NULL, ==, buf);
 
     /* Read mode */
 
@@ -79,5 +85,54 @@ int main(void) {
     test_pair_ptr_size("a" , fourkb, sizeof fourkb, sizeof fourkb, sizeof fourkb);
     test_pair_ptr_size("a+", fourkb, sizeof fourkb, sizeof fourkb, sizeof fourkb);
 
+    /* Queue mode */
+
+    test_pair_ptr_size("rq" , "short", 5, 5, 0);
+    test_pair_ptr_size("w+q", "short", 5, 0, 0);
+    test_pair_ptr_size("a+q", "short", 5, 5, 5);
+
+    /* Gap mode */
+
+    test_pair_ptr_size("r+g", "short", 5, 5, 0);
+    test_pair_ptr_size("wg" , "short", 5, 0, 0);
+
+    /* Segmented mode */
+
+    test_pair_ptr_size("rs" , "short", 5, 5, 0);
+    test_pair_ptr_size("w+s", "short", 5, 0, 0);
+    test_pair_ptr_size("as" , fourkb, sizeof fourkb, sizeof fourkb, sizeof fourkb);
+
+    /* Ring mode */
+
+    buf = bopen(NULL, 0, "wc");
+    TEST_PCMP("create ring | without plus", NULL, ==, buf);
+    buf = bopen(NULL, 0, "w+qc");
+    TEST_PCMP("create ring | with queue", NULL, ==, buf);
+    buf = bopen("short", 5, "r+c");
+    TEST_PCMP("create ring | not empty", NULL, !=, buf);
+    TEST_ICMP("create ring | not empty", 's', ==, bgetc(buf));
+    TEST_PCMP("create ring | no view", NULL, ==, bview(buf).base);
+    bclose(buf);
+    buf = bopen("short", 5, "w+c");
+    TEST_PCMP("create ring | write mode", NULL, !=, buf);
+    TEST_ICMP("create ring | write mode", EOB, ==, bgetc(buf));
+    bclose(buf);
+
+    /* Concurrent append mode */
+
+    buf = bopen(NULL, 0, "rm");
+    TEST_PCMP("create concurrent | read only", NULL, ==, buf);
+    buf = bopen(NULL, 0, "w+cm");
+    TEST_PCMP("create concurrent | with ring", NULL, ==, buf);
+    buf = bopen("short", 5, "a+m");
+    TEST_PCMP("create concurrent | not empty", NULL, !=, buf);
+    TEST_ICMP("create concurrent | not empty", 's', ==, bgetc(buf));
+    TEST_PCMP("create concurrent | no view", NULL, ==, bview(buf).base);
+    bclose(buf);
+    buf = bopen("short", 5, "am");
+    TEST_PCMP("create concurrent | write only", NULL, !=, buf);
+    TEST_ICMP("create concurrent | write only", EOB, ==, bgetc(buf));
+    bclose(buf);
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+static size_t lastsize;
+
+static void* counted(void* ptr, size_t size, void* ud) {
+    if (size) lastsize = size;
+    *(int*)ud += 1;
+    if (size) return realloc(ptr, size);
+    free(ptr);
+    return NULL;
+}
+
+static void* refuse(void* ptr, size_t size, void* ud) {
+    (void)ptr; (void)size; (void)ud;
+    return NULL;
+}
+
+static void* limited(void* ptr, size_t size, void* ud) {
+    (void)ud;
+    if (size > 2048) return NULL;
+    if (size) return realloc(ptr, size);
+    free(ptr);
+    return NULL;
+}
+
+int main(void) {
+    BUFFER* buf; BOPTIONS opts; BUFVIEW bvw;
+    char data[4096], text[16]; int calls = 0, i, num; bpos_t pos = 0;
+
+    memset(data, 'x', sizeof data);
+
+    TEST_PCMP("call with null pointer", NULL, ==, bopenex(NULL));
+
+    memset(&opts, 0, sizeof opts);
+    TEST_PCMP("call with null mode", NULL, ==, bopenex(&opts));
+
+    opts.mode = "w";
+    opts.userdata = &calls;
+    TEST_PCMP("call with userdata only", NULL, ==, bopenex(&opts));
+
+    opts.allocator = counted;
+    opts.growth = 100;
+    TEST_PCMP("call with not growing", NULL, ==, bopenex(&opts));
+
+    opts.growth = 33554433u;
+    TEST_PCMP("call with overflowing growth", NULL, ==, bopenex(&opts));
+
+    /* Allocator */
+
+    memset(&opts, 0, sizeof opts);
+    opts.data = "Text";
+    opts.size = 4;
+    opts.mode = "r";
+    opts.allocator = counted;
+    opts.userdata = &calls;
+    buf = bopenex(&opts);
+    TEST_PCMP("own allocator", NULL, !=, buf);
+    TEST_ICMP("own allocator", 2, ==, calls);
+    bvw = bview(buf);
+    TEST_MCMP("own allocator", "Text", bvw.base, 4);
+    bclose(buf);
+    TEST_ICMP("own allocator", 4, ==, calls);
+
+    bsetalloc(refuse, NULL);
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w";
+    TEST_PCMP("global allocator is not used", NULL, ==, bopen(NULL, 0, "w"));
+    buf = bopenex(&opts);
+    TEST_PCMP("global allocator is not used", NULL, !=, buf);
+    TEST_ICMP("global allocator is not used", 1, ==, (int)bwrite("x", 1, 1, buf));
+    bclose(buf);
+    bsetalloc(NULL, NULL);
+
+    /* Capacity and growth */
+
+    calls = 0;
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w";
+    opts.allocator = counted;
+    opts.userdata = &calls;
+    opts.capacity = 4096;
+    buf = bopenex(&opts);
+    TEST_ICMP("initial capacity", 2, ==, calls);
+    TEST_ICMP("initial capacity", 4096, ==, (int)lastsize);
+    TEST_ICMP("initial capacity", 4096, ==, (int)bwrite(data, 1, sizeof data, buf));
+    TEST_ICMP("initial capacity | no growth", 2, ==, calls);
+    bclose(buf);
+
+    calls = 0;
+    opts.capacity = 1000;
+    opts.growth = 200;
+    buf = bopenex(&opts);
+    for (i = 0; i < 8; i++)
+        bwrite(data, 1, 1000, buf);
+    TEST_ICMP("doubling growth", 5, ==, calls);
+    TEST_ICMP("doubling growth", 8000, ==, (int)lastsize);
+    bvw = bview(buf);
+    TEST_ICMP("doubling growth", 8000, ==, BV_LEN(bvw, base, stop));
+    bclose(buf);
+
+    calls = 0;
+    opts.capacity = 1000;
+    opts.growth = 200;
+    opts.threshold = 4000;
+    opts.step = 3000;
+    buf = bopenex(&opts);
+    for (i = 0; i < 8; i++)
+        bwrite(data, 1, 1000, buf);
+    TEST_ICMP("linear growth", 6, ==, calls);
+    TEST_ICMP("linear growth", 10000, ==, (int)lastsize);
+    bclose(buf);
+
+    calls = 0;
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w";
+    opts.allocator = counted;
+    opts.userdata = &calls;
+    opts.exact = 1;
+    buf = bopenex(&opts);
+    bwrite(data, 1, 10, buf);
+    TEST_ICMP("exact growth", 10, ==, (int)lastsize);
+    bwrite(data, 1, 15, buf);
+    TEST_ICMP("exact growth", 25, ==, (int)lastsize);
+    TEST_ICMP("exact growth", 3, ==, calls);
+    bclose(buf);
+
+    /* Ring mode */
+
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w+c";
+    opts.capacity = 1000;
+    buf = bopenex(&opts);
+    TEST_PCMP("ring", NULL, !=, buf);
+    TEST_ICMP("ring | empty", 1, ==, beob(buf));
+    TEST_ICMP("ring | capacity", 1024, ==, (int)bwrite(data, 1, sizeof data, buf));
+    TEST_ICMP("ring | full", 0, ==, (int)bwrite(data, 1, 1, buf));
+    TEST_ICMP("ring | full", EOB, ==, bputc('x', buf));
+    TEST_ICMP("ring | read", 1000, ==, (int)bread(data, 1, 1000, buf));
+    TEST_ICMP("ring | wrap write", 1000, ==, (int)bwrite(data, 1, 1000, buf));
+    TEST_ICMP("ring | wrap read", 1024, ==, (int)bread(data, 1, sizeof data, buf));
+    TEST_ICMP("ring | drained", EOB, ==, bgetc(buf));
+    for (i = 0; i < 300; i++) {
+        bprintf(buf, "%d line\n", i);
+        if (bscanf(buf, "%d %4s", &num, text) != 2 || num != i) break;
+        bgetc(buf);
+    }
+    TEST_ICMP("ring | formatted across wrap", 300, ==, i);
+    TEST_ICMP("ring | put string", 0, ==, bputs("abc\n", buf));
+    TEST_ICMP("ring | peek", 'a', ==, bpeek(buf));
+    TEST_PCMP("ring | get string", NULL, !=, bgets(text, sizeof text, buf));
+    TEST_SCMP("ring | get string", "abc\n", text);
+    TEST_ICMP("ring | seek", 0, !=, bseek(buf, 0, SEEK_SET));
+    TEST_ICMP("ring | set position", 0, !=, bsetpos(buf, &pos));
+    TEST_ICMP("ring | tell", -1, ==, (int)btell(buf));
+    TEST_ICMP("ring | insert", 0, !=, binsert("x", 1, buf));
+    TEST_ICMP("ring | put string", 0, ==, bputs("ab", buf));
+    TEST_ICMP("ring | read", 'a', ==, bgetc(buf));
+    TEST_ICMP("ring | unget", EOB, ==, bungetc('a', buf));
+    brewind(buf);
+    TEST_ICMP("ring | rewind", 'b', ==, bgetc(buf));
+    bclose(buf);
+
+    opts.capacity = 8;
+    buf = bopenex(&opts);
+    bputs("abcdef", buf);
+    TEST_ICMP("ring | print over free part", EOB, ==, bprintf(buf, "%d\n", 12345));
+    TEST_ICMP("ring | print over free part", 6, ==, (int)bread(text, 1, sizeof text, buf));
+    TEST_MCMP("ring | print over free part", "abcdef", text, 6);
+    TEST_ICMP("ring | print over free part", EOB, ==, bgetc(buf));
+    TEST_ICMP("ring | print whole record", 6, ==, bprintf(buf, "%d\n", 12345));
+    TEST_ICMP("ring | print whole record", 6, ==, (int)bread(text, 1, sizeof text, buf));
+    TEST_MCMP("ring | print whole record", "12345\n", text, 6);
+    bclose(buf);
+
+    opts.reserve = 1 << 20;
+    TEST_PCMP("ring | reserved", NULL, ==, bopenex(&opts));
+
+    /* Concurrent append mode */
+
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w+m";
+    opts.capacity = 16;
+    buf = bopenex(&opts);
+    TEST_PCMP("concurrent", NULL, !=, buf);
+    TEST_ICMP("concurrent | empty", 1, ==, beob(buf));
+    TEST_ICMP("concurrent | print", 6, ==, bprintf(buf, "%d-%s|", 12, "ab"));
+    TEST_ICMP("concurrent | grow", 100, ==, (int)bwrite(data, 1, 100, buf));
+    TEST_ICMP("concurrent | put string", 0, ==, bputs("end", buf));
+    TEST_ICMP("concurrent | put char", '!', ==, bputc('!', buf));
+    TEST_ICMP("concurrent | long print", 300, ==, bprintf(buf, "%300s", "text"));
+    TEST_ICMP("concurrent | scan", 2, ==, bscanf(buf, "%d-%2s", &num, text));
+    TEST_ICMP("concurrent | scan", 12, ==, num);
+    TEST_ICMP("concurrent | peek", '|', ==, bpeek(buf));
+    bgetc(buf);
+    TEST_ICMP("concurrent | read", 100, ==, (int)bread(data, 1, 100, buf));
+    TEST_PCMP("concurrent | get string", NULL, !=, bgets(text, 5, buf));
+    TEST_SCMP("concurrent | get string", "end!", text);
+    TEST_ICMP("concurrent | long read", 300, ==, (int)bread(data, 1, 300, buf));
+    TEST_MCMP("concurrent | long read", "text", data + 296, 4);
+    TEST_ICMP("concurrent | drained", 1, ==, beob(buf));
+    TEST_ICMP("concurrent | seek", 0, !=, bseek(buf, 0, SEEK_SET));
+    TEST_ICMP("concurrent | set position", 0, !=, bsetpos(buf, &pos));
+    TEST_ICMP("concurrent | tell", -1, ==, (int)btell(buf));
+    TEST_ICMP("concurrent | unget", EOB, ==, bungetc('!', buf));
+    brewind(buf);
+    TEST_ICMP("concurrent | rewind", 1, ==, beob(buf));
+    TEST_ICMP("concurrent | erase", 0, !=, berase(buf, 1));
+    bclose(buf);
+
+    opts.allocator = limited;
+    buf = bopenex(&opts);
+    TEST_ICMP("concurrent | failed growth", 10, ==, (int)bwrite(data, 1, 10, buf));
+    TEST_ICMP("concurrent | failed growth", 0, ==, (int)bwrite(data, 1, 4000, buf));
+    TEST_ICMP("concurrent | after failed growth", 0, ==, (int)bwrite(data, 1, 1, buf));
+    TEST_ICMP("concurrent | after failed growth", 10, ==, (int)bread(data, 1, 100, buf));
+    bclose(buf);
+
+    opts.allocator = refuse;
+    TEST_PCMP("concurrent | failed allocation", NULL, ==, bopenex(&opts));
+
+#if defined(__unix__) || defined(__APPLE__)
+    /* Reserved address range */
+
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w+";
+    opts.reserve = 1 << 20;
+    opts.hugepages = 1;
+    buf = bopenex(&opts);
+    TEST_PCMP("reserved range", NULL, !=, buf);
+    bwrite(data, 1, 10, buf);
+    bvw = bview(buf);
+    for (i = 0; i < 300; i++)
+        bwrite(data, 1, sizeof data, buf);
+    TEST_PCMP("reserved range | never moves", bvw.base, ==, bview(buf).base);
+    TEST_ICMP("reserved range | limit", 0, ==, (int)bwrite(data, 1, sizeof data, buf));
+    TEST_ICMP("reserved range | shrink", 0, ==, bshrink(buf));
+    TEST_ICMP("reserved range | reset", 0, ==, breset(buf));
+    TEST_PCMP("reserved range | reset", bvw.base, ==, bview(buf).base);
+    TEST_ICMP("reserved range | after reset", 4, ==, (int)bwrite("data", 1, 4, buf));
+    brewind(buf);
+    TEST_ICMP("reserved range | after reset", 'd', ==, bgetc(buf));
+    TEST_PCMP("reserved range | detach", NULL, ==, bdetach(buf, NULL));
+    bclose(buf);
+
+    opts.mode = "ws";
+    TEST_PCMP("reserved range | segmented", NULL, ==, bopenex(&opts));
+#endif
+
+    return EXIT_SUCCESS;
+}
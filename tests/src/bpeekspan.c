@@ -0,0 +1,35 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; const char* ptr; size_t len;
+
+    TEST_PCMP("call with null pointer", NULL, ==, bpeekspan(NULL, NULL));
+
+    buf = bopen(NULL, 0, "w+");
+    TEST_PCMP("call with not allocated data", NULL, ==, bpeekspan(buf, &len));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "a");
+    TEST_PCMP("call with not readable", NULL, ==, bpeekspan(buf, &len));
+    bclose(buf);
+
+    buf = bopen("Two words", 9, "r");
+    ptr = bpeekspan(buf, &len);
+    TEST_ICMP("peek from start", 9, ==, (int)len);
+    TEST_MCMP("peek from start", "Two words", ptr, 9);
+
+    bseek(buf, 4, BSEEK_SET);
+    ptr = bpeekspan(buf, &len);
+    TEST_ICMP("peek from middle", 5, ==, (int)len);
+    TEST_MCMP("peek from middle", "words", ptr, 5);
+    TEST_ICMP("peek from middle", 4, ==, (int)btell(buf));
+
+    bseek(buf, 0, BSEEK_END);
+    ptr = bpeekspan(buf, &len);
+    TEST_PCMP("peek from end", NULL, !=, ptr);
+    TEST_ICMP("peek from end", 0, ==, (int)len);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char big[20000];
+    BPOOL* pool; BUFFER *buf, *again, *other; BUFVIEW bvw;
+    char base[8]; size_t avail = 0;
+
+    TEST_PCMP("call with null pointer", NULL, ==, bpoolget(NULL, 0, "w"));
+    TEST_ICMP("call with null pointer", EOB, ==, bpoolput(NULL, NULL));
+
+    pool = bpoolopen(1 << 20);
+    TEST_PCMP("open pool", NULL, !=, pool);
+    TEST_PCMP("call with null mode"    , NULL, ==, bpoolget(pool, 0, NULL));
+    TEST_PCMP("call with reading mode" , NULL, ==, bpoolget(pool, 0, "r"));
+    TEST_PCMP("call with segmented"    , NULL, ==, bpoolget(pool, 0, "ws"));
+
+    /* Recycling */
+
+    buf = bpoolget(pool, 100, "w+");
+    TEST_PCMP("get new", NULL, !=, buf);
+    bprintf(buf, "request %d", 1);
+    TEST_ICMP("put", 0, ==, bpoolput(pool, buf));
+
+    again = bpoolget(pool, 1000, "w+q");
+    TEST_PCMP("get recycled", buf, ==, again);
+    bvw = bview(again);
+    TEST_ICMP("get recycled | empty", 0, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("get recycled | empty", EOB, ==, bgetc(again));
+    bputs("fresh", again);
+    brewind(again);
+    TEST_ICMP("get recycled | mode", 'f', ==, bgetc(again));
+
+    other = bpoolget(pool, 5000, "w");
+    TEST_PCMP("get greater class", again, !=, other);
+    bwrite(big, 1, sizeof big, other);
+    bpoolput(pool, other);
+    bpoolput(pool, again);
+    TEST_PCMP("get with invalid mode", NULL, ==, bpoolget(pool, 10000, "wx"));
+    TEST_PCMP("get from greater class", other, ==, bpoolget(pool, 10000, "w"));
+    TEST_PCMP("get from greater class | capacity", NULL, !=, bwritebegin(other, 0, &avail));
+    TEST_ICMP("get from greater class | capacity", (int)sizeof big, <=, (int)avail);
+    TEST_PCMP("get from smaller class", again, ==, bpoolget(pool, 500, "w"));
+    bclose(other);
+    bclose(again);
+
+    /* Not recycled buffers */
+
+    buf = bmemopen(base, sizeof base, "w");
+    TEST_ICMP("put fixed", 0, ==, bpoolput(pool, buf));
+    buf = bopen(NULL, 0, "ws");
+    TEST_ICMP("put segmented", 0, ==, bpoolput(pool, buf));
+    bpoolclose(pool);
+
+    pool = bpoolopen(1500);
+    buf   = bpoolget(pool, 0, "w");
+    other = bpoolget(pool, 0, "w");
+    bpoolput(pool, buf);
+    bpoolput(pool, other);
+    again = bopen(NULL, 0, "w"); /* may take memory of closed buffer */
+    TEST_PCMP("limit of retained", buf, ==, bpoolget(pool, 0, "w"));
+    other = bpoolget(pool, 0, "w+");
+    TEST_PCMP("limit of retained", NULL, !=, other);
+    TEST_PCMP("limit of retained", again, !=, other);
+    bclose(again);
+    bclose(other);
+    bclose(buf);
+    bpoolclose(pool);
+
+    return EXIT_SUCCESS;
+}
@@ -345,5 +345,25 @@ int main(void) {
 
     }
 
+    /* Segmented mode */
+
+    {
+    BUFFER* buf; char word[16]; int num, i, pos;
+
+    buf = bopen(NULL, 0, "w+s");
+    for (i = 0; i < 20000; i++)
+        bprintf(buf, "%05d:%s;", i, i % 2 ? "odd" : "even");
+
+    /* find record which crosses the first block boundary */
+    for (i = pos = 0; pos + 11 - i % 2 <= 65536; i++)
+        pos += 11 - i % 2;
+
+    bseek(buf, pos, BSEEK_SET);
+    TEST_ICMP("segmented | scan over blocks", 2, ==, bscanf(buf, "%d:%[a-z];", &num, word));
+    TEST_ICMP("segmented | scan over blocks", i, ==, num);
+    TEST_SCMP("segmented | scan over blocks", i % 2 ? "odd" : "even", word);
+    bclose(buf);
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
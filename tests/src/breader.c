@@ -0,0 +1,41 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BREADER first, second; BUFVIEW bvw;
+
+    first = breader(NULL);
+    TEST_PCMP("call with null pointer", NULL, ==, first.buffer);
+    TEST_ICMP("call with null pointer", EOB, ==, brgetc(&first));
+
+    buf = bopen(NULL, 0, "w");
+    first = breader(buf);
+    TEST_PCMP("call with not readable", NULL, ==, first.buffer);
+    bclose(buf);
+
+    /* Independent positions */
+
+    buf = bopen("Text", 4, "r");
+    first = breader(buf);
+    second = breader(buf);
+    TEST_ICMP("first reader" , 'T', ==, brgetc(&first));
+    TEST_ICMP("first reader" , 'e', ==, brgetc(&first));
+    TEST_ICMP("second reader", 'T', ==, brgetc(&second));
+    TEST_ICMP("buffer position", 'T', ==, bgetc(buf));
+    TEST_ICMP("first reader" , 'x', ==, brgetc(&first));
+    bclose(buf);
+
+    /* Gap is closed at creation */
+
+    buf = bopen("Text", 4, "r+g");
+    bseek(buf, 2, BSEEK_SET);
+    binsert("--", 2, buf);
+    first = breader(buf);
+    bvw = bview(buf);
+    TEST_MCMP("gap mode", "Te--xt", bvw.base, 6);
+    first.pos = 2;
+    TEST_ICMP("gap mode", '-', ==, brgetc(&first));
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,44 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; char head[5], body[8]; size_t ret;
+    BUFVEC vec[3];
+
+    vec[0].base = head; vec[0].size = sizeof head;
+    vec[1].base = NULL; vec[1].size = 0;
+    vec[2].base = body; vec[2].size = sizeof body;
+
+    TEST_ICMP("call with null pointer", 0, ==, breadv(NULL, NULL, 0));
+
+    buf = bopen(NULL, 0, "r");
+    TEST_ICMP("call with not allocated data", 0, ==, breadv(buf, vec, 3));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "a");
+    TEST_ICMP("call with not readable", 0, ==, breadv(buf, vec, 3));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with null vector", 0, ==, breadv(buf, NULL, 3));
+    TEST_ICMP("call with zero count" , 0, ==, breadv(buf, vec , 0));
+    bclose(buf);
+
+    buf = bopen("head body and tail", 18, "r");
+    ret = breadv(buf, vec, 3);
+    TEST_ICMP("read less than content", 13, ==, ret);
+    TEST_ICMP("read less than content", 13, ==, (int)btell(buf));
+    TEST_MCMP("read less than content", "head ", head, 5);
+    TEST_MCMP("read less than content", "body and", body, 8);
+
+    ret = breadv(buf, vec, 3);
+    TEST_ICMP("read greater than content", 5, ==, ret);
+    TEST_ICMP("read greater than content", 18, ==, (int)btell(buf));
+    TEST_MCMP("read greater than content", " tail", head, 5);
+
+    ret = breadv(buf, vec, 3);
+    TEST_ICMP("read at the end", 0, ==, ret);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+static int frees;
+
+static void* counted(void* ptr, size_t size, void* ud) {
+    (void)ud;
+    if (size) return realloc(ptr, size);
+    frees += ptr != NULL;
+    free(ptr);
+    return NULL;
+}
+
+int main(void) {
+    BUFFER* buf; BOPTIONS opts; BUFVIEW bvw;
+    static char block[65536];
+    char base[16] = {0}, zeros[16] = {0};
+
+    TEST_ICMP("call with null pointer", 0, !=, bresetex(NULL, 0));
+
+    buf = bopen("Text", 4, "r+");
+    TEST_ICMP("call with unknown flag", 0, !=, bresetex(buf, 4));
+    bclose(buf);
+
+    /* Secure wipe */
+
+    buf = bmemopen(base, sizeof base, "w+");
+    bputs("secret", buf);
+    brewind(buf);
+    berase(buf, 3);
+    TEST_ICMP("wipe", 0, ==, bresetex(buf, BRESET_WIPE));
+    TEST_MCMP("wipe | storage", zeros, base, sizeof base);
+    bvw = bview(buf);
+    TEST_ICMP("wipe | length", 0, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("release of fixed", 0, ==, bresetex(buf, BRESET_RELEASE));
+    TEST_ICMP("release of fixed | write", 0, ==, bputs("Text", buf));
+    bclose(buf);
+
+    memset(base, 'x', sizeof base);
+    buf = bmemopen(base, sizeof base, "w+");
+    bputs("secret", buf);
+    brewind(buf);
+    berase(buf, 3);
+    TEST_ICMP("wipe used part", 0, ==, bresetex(buf, BRESET_WIPE));
+    TEST_MCMP("wipe used part | erased bytes", zeros, base, 6);
+    TEST_MCMP("wipe used part | unused capacity", "xxxxxxxxxx", base + 6, 10);
+    bclose(buf);
+
+    memset(base, 'x', sizeof base);
+    buf = bmemopen(base, sizeof base, "w+");
+    bputs("abc", buf);
+    breset(buf);
+    bputs("d", buf);
+    TEST_ICMP("wipe after reset", 0, ==, bresetex(buf, BRESET_WIPE));
+    TEST_MCMP("wipe after reset | content before reset", zeros, base, 3);
+    TEST_ICMP("wipe after reset | unused capacity", 'x', ==, base[3]);
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w+s");
+    bputs("secret", buf);
+    TEST_ICMP("wipe segmented", 0, ==, bresetex(buf, BRESET_WIPE));
+    bwrite(block, 1, sizeof block - 4, buf);
+    memcpy(bwritebegin(buf, 16, NULL), "SECRET-PASSWORD!", 16);
+    bwritecommit(buf, 16);
+    TEST_ICMP("wipe segmented | spare block", 0, ==, bresetex(buf, BRESET_WIPE));
+    bwrite(block, 1, sizeof block - 4, buf);
+    TEST_MCMP("wipe segmented | spare block", zeros, bwritebegin(buf, 16, NULL), 16);
+    bclose(buf);
+
+    /* Release of storage */
+
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w+";
+    opts.allocator = counted;
+    buf = bopenex(&opts);
+    bputs("data", buf);
+    TEST_ICMP("release", 0, ==, bresetex(buf, BRESET_WIPE | BRESET_RELEASE));
+    TEST_ICMP("release | storage is freed", 1, ==, frees);
+    TEST_ICMP("release | write", 0, ==, bputs("text", buf));
+    brewind(buf);
+    TEST_ICMP("release | read", 't', ==, bgetc(buf));
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,27 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char data[70000];
+    BUFFER* buf; BREADER reader;
+
+    TEST_ICMP("call with null pointer", EOB, ==, brgetc(NULL));
+
+    buf = bopen("ab", 2, "r");
+    reader = breader(buf);
+    TEST_ICMP("get first" , 'a', ==, brgetc(&reader));
+    TEST_ICMP("get second", 'b', ==, brgetc(&reader));
+    TEST_ICMP("get at end", EOB, ==, brgetc(&reader));
+    bclose(buf);
+
+    /* Segmented mode */
+
+    data[65536] = 'x';
+    buf = bopen(data, sizeof data, "rs");
+    reader = breader(buf);
+    reader.pos = 65536;
+    TEST_ICMP("segmented | second block", 'x', ==, brgetc(&reader));
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,33 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BREADER reader; char dest[8];
+
+    TEST_PCMP("call with null pointer", NULL, ==, brgets(NULL, 0, NULL));
+
+    buf = bopen(
+        "Alan Turing\n"
+        "Alonzo\n"
+    , 19, "r");
+    reader = breader(buf);
+
+    TEST_PCMP("call with null dest"  , NULL, ==, brgets(NULL, 0, &reader));
+    TEST_PCMP("call with zero length", NULL, ==, brgets(dest, 0, &reader));
+    TEST_PCMP("call with one length" , dest, ==, brgets(dest, 1, &reader));
+    TEST_ICMP("check one length", '\0', ==, dest[0]);
+
+    TEST_PCMP("extract Alan"  , dest, ==, brgets(dest, sizeof dest, &reader));
+    TEST_SCMP("extract Alan"  , "Alan Tu", dest);
+    TEST_PCMP("extract Alan"  , dest, ==, brgets(dest, sizeof dest, &reader));
+    TEST_SCMP("extract Alan"  , "ring\n", dest);
+    TEST_PCMP("extract Alonzo", dest, ==, brgets(dest, sizeof dest, &reader));
+    TEST_SCMP("extract Alonzo", "Alonzo\n", dest);
+    TEST_PCMP("extract nothing", NULL, ==, brgets(dest, sizeof dest, &reader));
+
+    TEST_PCMP("buffer position", dest, ==, bgets(dest, sizeof dest, buf));
+    TEST_SCMP("buffer position", "Alan Tu", dest);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
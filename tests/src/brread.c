@@ -0,0 +1,34 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char data[70000];
+    BUFFER* buf; BREADER reader; char dest[8];
+
+    TEST_ICMP("call with null pointer", 0, ==, (int)brread(NULL, 0, 0, NULL));
+
+    buf = bopen("0123456789", 10, "r");
+    reader = breader(buf);
+    TEST_ICMP("call with null dest", 0, ==, (int)brread(NULL, 1, 4, &reader));
+    TEST_ICMP("call with zero size", 0, ==, (int)brread(dest, 0, 4, &reader));
+
+    TEST_ICMP("read items", 2, ==, (int)brread(dest, 2, 2, &reader));
+    TEST_MCMP("read items", "0123", dest, 4);
+    TEST_ICMP("read whole items", 2, ==, (int)brread(dest, 3, 2, &reader));
+    TEST_MCMP("read whole items", "456789", dest, 6);
+    TEST_ICMP("read at end", 0, ==, (int)brread(dest, 1, 1, &reader));
+    TEST_ICMP("buffer position", '0', ==, bgetc(buf));
+    bclose(buf);
+
+    /* Segmented mode */
+
+    memcpy(data + 65532, "across", 6);
+    buf = bopen(data, sizeof data, "rs");
+    reader = breader(buf);
+    reader.pos = 65532;
+    TEST_ICMP("segmented | over blocks", 6, ==, (int)brread(dest, 1, 6, &reader));
+    TEST_MCMP("segmented | over blocks", "across", dest, 6);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
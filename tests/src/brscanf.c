@@ -0,0 +1,29 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BREADER first, second;
+    int x = 0, y = 0; char word[8];
+
+    TEST_ICMP("call with null pointer", 0, >, brscanf(NULL, "%d", &x));
+
+    buf = bopen("12 34 end", 9, "r");
+    first = breader(buf);
+    second = breader(buf);
+    TEST_ICMP("call with not format", 0, >, brscanf(&first, NULL));
+
+    TEST_ICMP("scan numbers", 2, ==, brscanf(&first, "%d %d", &x, &y));
+    TEST_ICMP("scan numbers", 12, ==, x);
+    TEST_ICMP("scan numbers", 34, ==, y);
+    TEST_ICMP("scan numbers | position", 5, ==, (int)first.pos);
+    TEST_ICMP("scan word", 1, ==, brscanf(&first, " %7s", word));
+    TEST_SCMP("scan word", "end", word);
+    TEST_ICMP("scan at end", 1, >, brscanf(&first, "%d", &x));
+
+    TEST_ICMP("other reader", 1, ==, brscanf(&second, "%d", &y));
+    TEST_ICMP("other reader", 12, ==, y);
+    TEST_ICMP("buffer position", '1', ==, bgetc(buf));
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+static char   output[100000];
+static size_t outsize;
+static int    calls;
+
+static int collect(const void* data, size_t size, void* ud) {
+    if (outsize + size > sizeof output) return 1;
+    memcpy(output + outsize, data, size);
+    outsize += size;
+    calls += ud != NULL;
+    return 0;
+}
+
+static int refuse(const void* data, size_t size, void* ud) {
+    (void)data; (void)size; (void)ud;
+    return 1;
+}
+
+int main(void) {
+    static char expect[100000];
+    BUFFER* buf; BUFVIEW bvw; char base[32];
+    int i, len, maxlen = 0;
+
+    TEST_ICMP("call with null pointer", 0, !=, bsetsink(NULL, collect, NULL, 0));
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with not writable", 0, !=, bsetsink(buf, collect, NULL, 0));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "ws");
+    TEST_ICMP("call with segmented", 0, !=, bsetsink(buf, collect, NULL, 0));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w");
+    TEST_ICMP("call with userdata only", 0, !=, bsetsink(buf, NULL, &calls, 0));
+    TEST_ICMP("remove sink", 0, ==, bsetsink(buf, NULL, NULL, 0));
+    bclose(buf);
+
+    /* Growable buffer */
+
+    buf = bopen(NULL, 0, "w");
+    TEST_ICMP("stream output", 0, ==, bsetsink(buf, collect, &calls, 256));
+    for (len = i = 0; i < 5000; i++) {
+        bprintf(buf, "line %d\n", i);
+        len += sprintf(expect + len, "line %d\n", i);
+        bvw = bview(buf);
+        if (maxlen < BV_LEN(bvw, base, stop)) maxlen = BV_LEN(bvw, base, stop);
+    }
+    TEST_ICMP("stream output | bounded memory", 256, >=, maxlen);
+    TEST_ICMP("stream output | sink is used", 0, <, calls);
+    TEST_ICMP("stream output | flush", 0, ==, bsync(buf));
+    TEST_ICMP("stream output | flush", EOB, ==, bgetc(buf));
+    TEST_ICMP("stream output", 0, ==, bclose(buf));
+    TEST_ICMP("stream output", len, ==, (int)outsize);
+    TEST_MCMP("stream output", expect, output, len);
+
+    /* Fixed buffer */
+
+    outsize = 0;
+    buf = bmemopen(base, sizeof base, "w");
+    bsetsink(buf, collect, NULL, 0);
+    for (i = 0; i < 100; i++)
+        bwrite("0123456789", 1, 10, buf);
+    TEST_ICMP("fixed output", 0, ==, bclose(buf));
+    TEST_ICMP("fixed output", 1000, ==, (int)outsize);
+    TEST_MCMP("fixed output", "789012", output + 997 - 10, 6);
+
+    /* Failed sink */
+
+    buf = bmemopen(base, 4, "w");
+    bsetsink(buf, refuse, NULL, 0);
+    TEST_ICMP("failed sink", 4, ==, (int)bwrite("abcd", 1, 4, buf));
+    TEST_ICMP("failed sink", EOB, ==, bputc('e', buf));
+    TEST_ICMP("failed sink", EOB, ==, bclose(buf));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+static char   input[100000];
+static size_t insize;
+static size_t inpos;
+
+/* gives input by small parts to cross the end of buffer often */
+static size_t supply(void* data, size_t size, void* ud) {
+    size_t len = insize - inpos;
+    if (len > size) len = size;
+    if (len > 7) len = 7;
+    memcpy(data, input + inpos, len);
+    inpos += len;
+    (void)ud;
+    return len;
+}
+
+static void restart(void) {
+    inpos = 0;
+}
+
+int main(void) {
+    BUFFER* buf; char window[64], line[32], data[16];
+    int i, value, failed;
+
+    for (i = 0; i < 5000; i++)
+        insize += sprintf(input + insize, "%d line\n", i);
+
+    TEST_ICMP("call with null pointer", 0, !=, bsetsource(NULL, supply, NULL));
+
+    buf = bopen(NULL, 0, "w");
+    TEST_ICMP("call with not readable", 0, !=, bsetsource(buf, supply, NULL));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "rg");
+    TEST_ICMP("call with gap mode", 0, !=, bsetsource(buf, supply, NULL));
+    bclose(buf);
+
+    buf = bborrow("Text", 4);
+    TEST_ICMP("call with borrowed", 0, !=, bsetsource(buf, supply, NULL));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "r");
+    TEST_ICMP("call with userdata only", 0, !=, bsetsource(buf, NULL, &value));
+    TEST_ICMP("remove source", 0, ==, bsetsource(buf, NULL, NULL));
+    bclose(buf);
+
+    /* Formatted input */
+
+    restart();
+    buf = bmemopen(window, sizeof window, "w+");
+    TEST_ICMP("stream scanf", 0, ==, bsetsource(buf, supply, NULL));
+    for (failed = i = 0; i < 5000; i++)
+        if (bscanf(buf, "%d line ", &value) != 1 || value != i) failed++;
+    TEST_ICMP("stream scanf | all lines", 0, ==, failed);
+    TEST_ICMP("stream scanf | end", 1, ==, beob(buf));
+    TEST_ICMP("stream scanf | end", EOB, ==, bgetc(buf));
+    bclose(buf);
+
+    /* Unformatted input */
+
+    restart();
+    buf = bopen(NULL, 0, "r");
+    bsetsource(buf, supply, NULL);
+    for (failed = i = 0; i < 5000; i++) {
+        sprintf(data, "%d line\n", i);
+        if (!bgets(line, sizeof line, buf) || strcmp(line, data)) failed++;
+    }
+    TEST_ICMP("stream gets | all lines", 0, ==, failed);
+    TEST_PCMP("stream gets | end", NULL, ==, bgets(line, sizeof line, buf));
+    bclose(buf);
+
+    restart();
+    buf = bopen("0 li", 4, "r");
+    bsetsource(buf, supply, NULL);
+    TEST_ICMP("stream read", 1, ==, (int)bread(data, 16, 1, buf));
+    TEST_MCMP("stream read", "0 li0 line\n1 lin", data, 16);
+    TEST_ICMP("stream read", 'e', ==, bpeek(buf));
+    bclose(buf);
+
+    /* Short window */
+
+    restart();
+    buf = bmemopen(window, 4, "w+");
+    bsetsource(buf, supply, NULL);
+    TEST_ICMP("short window", 0, ==, (int)bread(data, 8, 1, buf));
+    TEST_PCMP("short window", line, ==, bgets(line, sizeof line, buf));
+    TEST_SCMP("short window", "0 li", line);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
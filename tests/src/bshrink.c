@@ -0,0 +1,74 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+static size_t lastsize;
+
+static void* counted(void* ptr, size_t size, void* ud) {
+    if (size) lastsize = size;
+    *(int*)ud += 1;
+    if (size) return realloc(ptr, size);
+    free(ptr);
+    return NULL;
+}
+
+int main(void) {
+    static char data[200000];
+    BUFFER* buf; BOPTIONS opts; BUFVIEW bvw; BUFSPAN spans[4];
+    char base[8]; int calls = 0;
+
+    memset(data, 'x', sizeof data);
+
+    TEST_ICMP("call with null pointer", 0, !=, bshrink(NULL));
+
+    buf = bmemopen(base, sizeof base, "w");
+    TEST_ICMP("call with fixed buffer", 0, !=, bshrink(buf));
+    bclose(buf);
+
+    memset(&opts, 0, sizeof opts);
+    opts.mode = "w+";
+    opts.allocator = counted;
+    opts.userdata = &calls;
+    buf = bopenex(&opts);
+    TEST_ICMP("shrink without storage", 0, ==, bshrink(buf));
+
+    bwrite(data, 1, 5000, buf);
+    TEST_ICMP("shrink to content", 0, ==, bshrink(buf));
+    TEST_ICMP("shrink to content", 5000, ==, (int)lastsize);
+    bvw = bview(buf);
+    TEST_ICMP("shrink to content | length", 5000, ==, (int)BV_LEN(bvw, base, stop));
+    TEST_ICMP("shrink to content | write", 1, ==, (int)bwrite("y", 1, 1, buf));
+    bclose(buf);
+
+    /* Queue and gap modes */
+
+    buf = bopen(NULL, 0, "w+q");
+    bputs("0123456789", buf);
+    brewind(buf);
+    berase(buf, 4);
+    TEST_ICMP("shrink queue", 0, ==, bshrink(buf));
+    bvw = bview(buf);
+    TEST_ICMP("shrink queue | content", 6, ==, (int)BV_LEN(bvw, base, stop));
+    TEST_MCMP("shrink queue | content", "456789", bvw.base, 6);
+    bclose(buf);
+
+    buf = bopen("0123456789", 10, "r+g");
+    bseek(buf, 5, BSEEK_SET);
+    binsert("abc", 3, buf);
+    TEST_ICMP("shrink gap", 0, ==, bshrink(buf));
+    bvw = bview(buf);
+    TEST_MCMP("shrink gap | content", "01234abc56789", bvw.base, 13);
+    bclose(buf);
+
+    /* Segmented mode */
+
+    buf = bopen(NULL, 0, "w+s");
+    bwrite(data, 1, sizeof data, buf);
+    bseek(buf, 100, BSEEK_SET);
+    berase(buf, sizeof data - 200);
+    TEST_ICMP("shrink segmented", 0, ==, bshrink(buf));
+    TEST_ICMP("shrink segmented | blocks", 1, ==, (int)bviewv(buf, spans, 4));
+    TEST_ICMP("shrink segmented | length", 200, ==, (int)spans[0].size);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
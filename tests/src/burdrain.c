@@ -0,0 +1,76 @@
+#define _POSIX_C_SOURCE 200112L
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+#ifdef IOBUFFER_URING
+
+#include <iobuffer/iouring.h>
+#include <unistd.h>
+#include <errno.h>
+
+int main(void) {
+    BURING* ring; BUFFER* bufs[3]; BUFVIEW bvw; BUREVENT events[4];
+    char back[64]; int fds[2], i, total;
+
+    TEST_ICMP("call with null pointer", 0, !=, burdrain(NULL, NULL, 0, NULL));
+
+    ring = buropen(4);
+    if (!ring && (errno == ENOSYS || errno == EPERM))
+        return EXIT_SUCCESS; /* io_uring is disabled in system */
+    TEST_PCMP("open ring", NULL, !=, ring);
+
+    bufs[0] = bopen("Text", 4, "a");
+    TEST_ICMP("call with not readable", 0, !=, burdrain(ring, bufs[0], 0, NULL));
+    bclose(bufs[0]);
+
+    bufs[0] = bopen("Text", 4, "r");
+    bseek(bufs[0], 0, BSEEK_END);
+    TEST_ICMP("call at end", 0, !=, burdrain(ring, bufs[0], 0, NULL));
+    bclose(bufs[0]);
+
+    if (pipe(fds)) return EXIT_FAILURE;
+
+    /* Several buffers with one submit */
+
+    bufs[0] = bopen("one ", 4, "r");
+    bufs[1] = bopen("two ", 4, "r");
+    bufs[2] = bopen(NULL, 0, "w+q");
+    bputs("three", bufs[2]);
+    brewind(bufs[2]);
+    for (i = 0; i < 3; i++)
+        TEST_ICMP("drain to pipe", 0, ==, burdrain(ring, bufs[i], fds[1], bufs + i));
+
+    for (total = 0; total < 3; total += i) {
+        i = burwait(ring, events + total, 4 - total, 1);
+        TEST_ICMP("drain to pipe | wait", 0, <, i);
+    }
+    for (i = 0; i < 3; i++) {
+        TEST_ICMP("drain to pipe | event", 1, ==, events[i].drain);
+        TEST_PCMP("drain to pipe | event", *(BUFFER**)events[i].userdata, ==, events[i].buffer);
+    }
+
+    TEST_ICMP("drain to pipe", 4, ==, (int)btell(bufs[0]));
+    TEST_ICMP("drain to pipe", 4, ==, (int)btell(bufs[1]));
+    bvw = bview(bufs[2]);
+    TEST_ICMP("drain queue | written are erased", 0, ==, BV_LEN(bvw, base, stop));
+
+    TEST_ICMP("drain to pipe | content", 13, ==, (int)read(fds[0], back, sizeof back));
+    TEST_ICMP("drain to pipe | content", 0, !=, memchr(back, 'h', 13) != NULL);
+
+    for (i = 0; i < 3; i++)
+        bclose(bufs[i]);
+    close(fds[0]);
+    close(fds[1]);
+
+    TEST_ICMP("close ring", 0, ==, burclose(ring));
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(void) {
+    (void)filename; /* io_uring engine is not built */
+    return EXIT_SUCCESS;
+}
+
+#endif
@@ -0,0 +1,171 @@
+#define _POSIX_C_SOURCE 200112L
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+#ifdef IOBUFFER_URING
+
+#include <iobuffer/iouring.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define TMPFILE "burfill_" TOSTR(__STDC_VERSION__) ".tmp"
+
+int main(void) {
+    BURING* ring; BPOOL* pool; BCACHE* cache; BUFFER *buf, *fixed, *other; BUFVIEW bvw; BUREVENT events[4];
+    char base[16]; int fds[2], tag; FILE* file;
+
+    TEST_PCMP("open with zero entries", NULL, ==, buropen(0));
+    TEST_ICMP("call with null pointer", 0, !=, burfill(NULL, NULL, 0, 1, NULL));
+    TEST_ICMP("call with null pointer", EOB, ==, burwait(NULL, events, 4, 0));
+    TEST_ICMP("call with null pointer", EOB, ==, burclose(NULL));
+
+    ring = buropen(8);
+    if (!ring && (errno == ENOSYS || errno == EPERM))
+        return EXIT_SUCCESS; /* io_uring is disabled in system */
+    TEST_PCMP("open ring", NULL, !=, ring);
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with not writable", 0, !=, burfill(ring, buf, 0, 1, NULL));
+    bclose(buf);
+
+    TEST_ICMP("nothing to wait", 0, ==, burwait(ring, events, 4, 0));
+
+    /* Pipe */
+
+    if (pipe(fds)) return EXIT_FAILURE;
+    write(fds[1], "hello world", 11);
+
+    buf = bopen("> ", 2, "r+");
+    TEST_ICMP("fill from pipe", 0, ==, burfill(ring, buf, fds[0], 100, &tag));
+    TEST_ICMP("fill from pipe", 1, ==, burwait(ring, events, 4, 1));
+    TEST_PCMP("fill from pipe | event", buf , ==, events[0].buffer);
+    TEST_PCMP("fill from pipe | event", &tag, ==, events[0].userdata);
+    TEST_ICMP("fill from pipe | event", 11, ==, (int)events[0].result);
+    TEST_ICMP("fill from pipe | event", 0, ==, events[0].drain);
+
+    bvw = bview(buf);
+    TEST_ICMP("fill from pipe | position is kept", 0, ==, BV_LEN(bvw, base, head));
+    TEST_ICMP("fill from pipe | content", 13, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("fill from pipe | content", "> hello world", bvw.base, 13);
+
+    close(fds[1]);
+    burfill(ring, buf, fds[0], 100, NULL);
+    TEST_ICMP("fill at end of file", 1, ==, burwait(ring, events, 4, 1));
+    TEST_ICMP("fill at end of file", 0, ==, (int)events[0].result);
+    close(fds[0]);
+    bclose(buf);
+
+    /* Operation in flight */
+
+    if (pipe(fds)) return EXIT_FAILURE;
+
+    buf = bopen(NULL, 0, "w+");
+    bputs("> ", buf);
+    TEST_ICMP("in flight | fill", 0, ==, burfill(ring, buf, fds[0], 100, NULL));
+    TEST_ICMP("in flight | submit", 0, ==, burwait(ring, events, 4, 0));
+    TEST_ICMP("in flight | second fill", 0, !=, burfill(ring, buf, fds[0], 100, NULL));
+    TEST_ICMP("in flight | drain", 0, !=, burdrain(ring, buf, fds[1], NULL));
+
+    /* storage is neither written nor released until completion */
+    TEST_ICMP("in flight | bputc", EOB, ==, bputc('x', buf));
+    TEST_ICMP("in flight | bputs", EOB, ==, bputs("x", buf));
+    TEST_ICMP("in flight | bwrite", 0, ==, (int)bwrite("x", 1, 1, buf));
+    TEST_ICMP("in flight | bprintf", 0, ==, bprintf(buf, "%i", 42));
+    TEST_ICMP("in flight | binsert", 0, !=, binsert("x", 1, buf));
+    TEST_ICMP("in flight | berase", 0, !=, berase(buf, 1));
+    TEST_ICMP("in flight | bungetc", EOB, ==, bungetc('x', buf));
+    TEST_PCMP("in flight | bwritebegin", NULL, ==, bwritebegin(buf, 1, NULL));
+    TEST_ICMP("in flight | bfillfd", EOB, ==, (int)bfillfd(buf, fds[0], 100));
+    TEST_ICMP("in flight | breset", 0, !=, breset(buf));
+    TEST_ICMP("in flight | bresetex", 0, !=, bresetex(buf, BRESET_RELEASE));
+    TEST_ICMP("in flight | bshrink", 0, !=, bshrink(buf));
+    TEST_PCMP("in flight | bdetach", NULL, ==, bdetach(buf, NULL));
+    TEST_ICMP("in flight | bfreeze", 0, !=, bfreeze(buf));
+    TEST_PCMP("in flight | bclone", NULL, ==, bclone(buf));
+    TEST_ICMP("in flight | bclose", EOB, ==, bclose(buf));
+    pool = bpoolopen(1 << 20);
+    cache = bcacheopen(pool);
+    TEST_ICMP("in flight | bpoolput", EOB, ==, bpoolput(pool, buf));
+    TEST_ICMP("in flight | bcacheput", EOB, ==, bcacheput(cache, buf));
+    other = bpoolget(pool, 0, "w");
+    TEST_PCMP("in flight | bpoolget", buf, !=, other);
+    bclose(other);
+    bcacheclose(cache);
+    bpoolclose(pool);
+
+    write(fds[1], "data", 4);
+    TEST_ICMP("in flight | completion", 1, ==, burwait(ring, events, 4, 1));
+    TEST_ICMP("in flight | completion", 4, ==, (int)events[0].result);
+    bvw = bview(buf);
+    TEST_ICMP("in flight | content", 6, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("in flight | content", "> data", bvw.base, 6);
+
+    write(fds[1], "more", 4);
+    TEST_ICMP("after completion | fill", 0, ==, burfill(ring, buf, fds[0], 100, NULL));
+    TEST_ICMP("after completion | fill", 1, ==, burwait(ring, events, 4, 1));
+    TEST_ICMP("after completion | fill", 4, ==, (int)events[0].result);
+
+    close(fds[0]);
+    close(fds[1]);
+    bclose(buf);
+
+    /* Registered buffer and file */
+
+    file = fopen(TMPFILE, "wb");
+    fputs("first second", file);
+    fclose(file);
+    file = fopen(TMPFILE, "rb");
+
+    buf   = bopen(NULL, 0, "w+");
+    fixed = bmemopen(base, sizeof base, "w+");
+    TEST_ICMP("register not fixed", 0, !=, burregister(ring, &buf, 1));
+    TEST_ICMP("register fixed", 0, ==, burregister(ring, &fixed, 1));
+    TEST_ICMP("register twice", 0, !=, burregister(ring, &fixed, 1));
+
+    TEST_ICMP("fill registered", 0, ==, burfill(ring, fixed, fileno(file), 6, NULL));
+    TEST_ICMP("fill registered", 1, ==, burwait(ring, events, 4, 1));
+    TEST_ICMP("fill registered", 6, ==, (int)events[0].result);
+    TEST_ICMP("fill registered", 0, ==, burfill(ring, fixed, fileno(file), 100, NULL));
+    TEST_ICMP("fill registered", 1, ==, burwait(ring, events, 4, 1));
+    TEST_ICMP("fill registered", 6, ==, (int)events[0].result);
+    bvw = bview(fixed);
+    TEST_ICMP("fill registered | content", 12, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("fill registered | content", "first second", base, 12);
+
+    bclose(fixed);
+    bclose(buf);
+    fclose(file);
+    remove(TMPFILE);
+
+    /* Close with operation in flight */
+
+    if (pipe(fds)) return EXIT_FAILURE;
+
+    write(fds[1], "done", 4);
+    buf   = bopen(NULL, 0, "w+");
+    fixed = bopen(NULL, 0, "w+");
+    TEST_ICMP("close in flight | fill", 0, ==, burfill(ring, buf, fds[0], 100, NULL));
+    TEST_ICMP("close in flight | fill", 0, ==, burfill(ring, fixed, fds[0], 100, NULL));
+    TEST_ICMP("close ring", 0, ==, burclose(ring));
+    bvw = bview(buf);
+    TEST_ICMP("close in flight | completed", 4, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("close in flight | completed", "done", bvw.base, 4);
+    TEST_ICMP("close in flight | cancelled", 'x', ==, bputc('x', fixed));
+    write(fds[1], "late", 4);
+    TEST_ICMP("close in flight | cancelled", 4, ==, (int)read(fds[0], base, sizeof base));
+    TEST_ICMP("close in flight | cancelled", 0, ==, bclose(fixed));
+    TEST_ICMP("close in flight | completed", 0, ==, bclose(buf));
+    close(fds[0]);
+    close(fds[1]);
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(void) {
+    (void)filename; /* io_uring engine is not built */
+    return EXIT_SUCCESS;
+}
+
+#endif
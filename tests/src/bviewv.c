@@ -0,0 +1,38 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char big[200000];
+    BUFFER* buf; BUFSPAN spans[4]; size_t ret, i, total;
+
+    TEST_ICMP("call with null pointer", 0, ==, (int)bviewv(NULL, NULL, 0));
+
+    buf = bopen(NULL, 0, "w");
+    TEST_ICMP("call with not allocated data", 0, ==, (int)bviewv(buf, spans, 4));
+    bclose(buf);
+
+    buf = bopen("Two words", 9, "r");
+    ret = bviewv(buf, spans, 4);
+    TEST_ICMP("contiguous", 1, ==, (int)ret);
+    TEST_ICMP("contiguous", 9, ==, (int)spans[0].size);
+    TEST_MCMP("contiguous", "Two words", spans[0].base, 9);
+    bclose(buf);
+
+    for (i = 0; i < sizeof big; i++)
+        big[i] = (char)(i * 7 + i / 251);
+
+    buf = bopen(big, sizeof big, "rs");
+    TEST_ICMP("segmented | count only", 4, ==, (int)bviewv(buf, NULL, 0));
+
+    ret = bviewv(buf, spans, 2);
+    TEST_ICMP("segmented | partial", 4, ==, (int)ret);
+    TEST_MCMP("segmented | partial", big, spans[0].base, spans[0].size);
+
+    ret = bviewv(buf, spans, 4);
+    for (total = i = 0; i < ret; total += spans[i++].size)
+        TEST_MCMP("segmented | all", big + total, spans[i].base, spans[i].size);
+    TEST_ICMP("segmented | all", sizeof big, ==, (int)total);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
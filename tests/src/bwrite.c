@@ -114,5 +114,31 @@ int main(void) {
     TEST_MCMP("write from end | greater than length", "beaver", bvw.base, 7);
     bclose(buf);
 
+    /* Segmented mode */
+
+    {
+    static char big[150000], back[150000];
+    size_t i;
+
+    for (i = 0; i < sizeof big; i++)
+        big[i] = (char)(i % 251);
+
+    buf = bopen(NULL, 0, "w+s");
+    ret = bwrite(big, 1, 70000, buf);
+    ret += bwrite(big + 70000, 1000, 80, buf);
+    TEST_ICMP("segmented | write over blocks", 70080, ==, (int)ret);
+    TEST_ICMP("segmented | write over blocks", sizeof big, ==, (int)btell(buf));
+
+    bseek(buf, 65530, BSEEK_SET);
+    bwrite("boundary", 1, 8, buf);
+    memcpy(big + 65530, "boundary", 8);
+
+    brewind(buf);
+    ret = bread(back, 1, sizeof back, buf);
+    TEST_ICMP("segmented | read over blocks", sizeof back, ==, (int)ret);
+    TEST_MCMP("segmented | read over blocks", big, back, sizeof back);
+    bclose(buf);
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char block[65536 - 3];
+    BUFFER* buf; BUFVIEW bvw;
+    char base[8]; char* ptr; size_t avail;
+
+    TEST_PCMP("call with null pointer", NULL, ==, bwritebegin(NULL, 0, NULL));
+
+    buf = bopen("Text", 4, "r");
+    TEST_PCMP("call with not writable", NULL, ==, bwritebegin(buf, 1, NULL));
+    bclose(buf);
+
+    buf = bmemopen(base, sizeof base, "w");
+    TEST_PCMP("call with too large size", NULL, ==, bwritebegin(buf, 9, NULL));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w");
+    ptr = bwritebegin(buf, 5, &avail);
+    TEST_PCMP("reserve in empty", NULL, !=, ptr);
+    TEST_ICMP("reserve in empty", 5, <=, (int)avail);
+    bvw = bview(buf);
+    TEST_ICMP("reserve in empty", 0, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("reserve in empty", 0, ==, BV_LEN(bvw, base, head));
+    bclose(buf);
+
+    strcpy(base, "beaver");
+    buf = bmemopen(base, sizeof base, "r+");
+    bseek(buf, 2, BSEEK_SET);
+    ptr = bwritebegin(buf, 0, &avail);
+    TEST_PCMP("reserve in fixed", base + 2, ==, ptr);
+    TEST_ICMP("reserve in fixed", 6, ==, (int)avail);
+    bclose(buf);
+
+    buf = bopen("abc", 3, "a");
+    ptr = bwritebegin(buf, 2000, &avail);
+    TEST_PCMP("reserve with growth", NULL, !=, ptr);
+    TEST_ICMP("reserve with growth", 2000, <=, (int)avail);
+    bvw = bview(buf);
+    TEST_PCMP("reserve with growth", (char*)bvw.base + 3, ==, ptr);
+    TEST_MCMP("reserve with growth", "abc", bvw.base, 3);
+    bclose(buf);
+
+    /* Segmented */
+
+    buf = bopen(NULL, 0, "w+s");
+    TEST_PCMP("segmented | too large size", NULL, ==, bwritebegin(buf, 65537, NULL));
+    bwrite(block, 1, sizeof block, buf);
+    ptr = bwritebegin(buf, 3, &avail);
+    TEST_PCMP("segmented | rest of block", NULL, !=, ptr);
+    TEST_ICMP("segmented | rest of block", 3, ==, (int)avail);
+
+    ptr = bwritebegin(buf, 10, &avail);
+    TEST_PCMP("segmented | over end of block", NULL, !=, ptr);
+    TEST_ICMP("segmented | over end of block", 65536, ==, (int)avail);
+    memcpy(ptr, "0123456789", 10);
+    TEST_ICMP("segmented | over end of block", 0, ==, bwritecommit(buf, 10));
+    TEST_ICMP("segmented | over end of block", (int)sizeof block + 10, ==, (int)btell(buf));
+    bseek(buf, -10, BSEEK_CUR);
+    TEST_PCMP("segmented | over end of block", NULL, !=, bgets(base, 8, buf));
+    TEST_SCMP("segmented | over end of block", "0123456", base);
+
+    ptr = bwritebegin(buf, 65536, &avail);
+    TEST_PCMP("segmented | whole block", NULL, !=, ptr);
+    TEST_ICMP("segmented | whole block", 65536, ==, (int)avail);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,68 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    static char block[65536 - 2];
+    BUFFER* buf; BUFVIEW bvw;
+    char base[8]; char* ptr; size_t avail;
+
+    TEST_ICMP("call with null pointer", 0, !=, bwritecommit(NULL, 0));
+
+    buf = bopen(NULL, 0, "w");
+    TEST_ICMP("call with not allocated data", 0, !=, bwritecommit(buf, 0));
+    bclose(buf);
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with not writable", 0, !=, bwritecommit(buf, 0));
+    bclose(buf);
+
+    buf = bmemopen(base, sizeof base, "w");
+    bwritebegin(buf, 0, &avail);
+    TEST_ICMP("commit more than available", 0, !=, bwritecommit(buf, avail + 1));
+    bclose(buf);
+
+    buf = bmemopen(base, sizeof base, "w");
+    ptr = bwritebegin(buf, 4, NULL);
+    memcpy(ptr, "ver", 3);
+    TEST_ICMP("commit to empty", 0, ==, bwritecommit(buf, 3));
+    bvw = bview(buf);
+    TEST_ICMP("commit to empty", 3, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("commit to empty", 3, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("commit to empty", "ver", bvw.base, 3);
+    bclose(buf);
+
+    strcpy(base, "beaver");
+    buf = bmemopen(base, sizeof base, "r+");
+    bseek(buf, 2, BSEEK_SET);
+    ptr = bwritebegin(buf, 2, NULL);
+    memcpy(ptr, "ee", 2);
+    TEST_ICMP("commit to middle", 0, ==, bwritecommit(buf, 2));
+    bvw = bview(buf);
+    TEST_ICMP("commit to middle", 8, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("commit to middle", 4, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("commit to middle", "beeeer", bvw.base, 6);
+    bclose(buf);
+
+    buf = bopen("abc", 3, "a");
+    ptr = bwritebegin(buf, 3000, &avail);
+    memset(ptr, 'x', 3000);
+    TEST_ICMP("commit with growth", 0, ==, bwritecommit(buf, 3000));
+    bvw = bview(buf);
+    TEST_ICMP("commit with growth", 3003, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("commit with growth", 3003, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("commit with growth", "abcxx", bvw.base, 5);
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w+s");
+    bwrite(block, 1, sizeof block, buf);
+    ptr = bwritebegin(buf, 4, &avail);
+    memcpy(ptr, "edge", 4);
+    TEST_ICMP("commit over end of block", 0, !=, bwritecommit(buf, avail + 1));
+    TEST_ICMP("commit over end of block", 0, ==, bwritecommit(buf, 4));
+    bseek(buf, -4, BSEEK_CUR);
+    TEST_ICMP("commit over end of block", 4, ==, (int)bread(base, 1, 4, buf));
+    TEST_MCMP("commit over end of block", "edge", base, 4);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#include <iobuffer/iobuffer.h>
+#include "test.h"
+
+int main(void) {
+    BUFFER* buf; BUFVIEW bvw; BUFSPAN spans[4];
+    char base[8]; size_t ret;
+    BUFVEC vec[3] = {{"head ", 5}, {NULL, 0}, {"body", 4}};
+
+    TEST_ICMP("call with null pointer", 0, ==, bwritev(NULL, NULL, 0));
+
+    buf = bopen("Text", 4, "r");
+    TEST_ICMP("call with not writable", 0, ==, bwritev(buf, vec, 3));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w");
+    TEST_ICMP("call with null vector", 0, ==, bwritev(buf, NULL, 3));
+    TEST_ICMP("call with zero count" , 0, ==, bwritev(buf, vec , 0));
+    bclose(buf);
+
+    buf = bopen(NULL, 0, "w");
+    ret = bwritev(buf, vec, 3);
+    bvw = bview(buf);
+    TEST_ICMP("write to growable", 9, ==, ret);
+    TEST_ICMP("write to growable", 9, ==, BV_LEN(bvw, base, stop));
+    TEST_ICMP("write to growable", 9, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("write to growable", "head body", bvw.base, 9);
+    bclose(buf);
+
+    buf = bopen("0123456789", 10, "r+");
+    bseek(buf, 2, BSEEK_SET);
+    ret = bwritev(buf, vec + 2, 1);
+    bvw = bview(buf);
+    TEST_ICMP("write over content", 4, ==, ret);
+    TEST_ICMP("write over content", 6, ==, BV_LEN(bvw, base, head));
+    TEST_MCMP("write over content", "01body6789", bvw.base, 10);
+    bclose(buf);
+
+    buf = bmemopen(base, sizeof base, "w");
+    ret = bwritev(buf, vec, 3);
+    bvw = bview(buf);
+    TEST_ICMP("write to fixed | greater than length", 8, ==, ret);
+    TEST_ICMP("write to fixed | greater than length", 8, ==, BV_LEN(bvw, base, stop));
+    TEST_MCMP("write to fixed | greater than length", "head bod", bvw.base, 8);
+    bclose(buf);
+
+    /* Segmented mode */
+
+    buf = bopen(NULL, 0, "ws");
+    bseek(buf, 0, BSEEK_SET);
+    for (ret = 0; ret < 10000; ret++)
+        bwritev(buf, vec, 3);
+    TEST_ICMP("write to segmented", 90000, ==, (int)btell(buf));
+    TEST_ICMP("write to segmented", 2, ==, (int)bviewv(buf, spans, 4));
+    TEST_MCMP("write to segmented", "yhead bo", (const char*)spans[0].base + 65528, 8);
+    TEST_MCMP("write to segmented", "dyhead", spans[1].base, 6);
+    bclose(buf);
+
+    return EXIT_SUCCESS;
+}